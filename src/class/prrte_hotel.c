@@ -19,28 +19,171 @@
 #include "src/class/prrte_hotel.h"
 
 
-static void local_eviction_callback(int fd, short flags, void *arg)
+/* the wheel turns once a second */
+#define PRRTE_HOTEL_TICK_SEC  1
+
+typedef struct {
+    int room_num;
+    void *occupant;
+} hotel_guest_t;
+
+static void wheel_tick(int fd, short flags, void *arg);
+
+/* Rebuild the list of unoccupied rooms so that the lowest numbered
+ * rooms are handed out first */
+static void reset_unoccupied(prrte_hotel_t *h)
+{
+    int i;
+
+    h->last_unoccupied_room = -1;
+    for (i = h->num_rooms - 1; 0 <= i; i--) {
+        if (NULL == h->rooms[i].occupant) {
+            h->unoccupied_rooms[++h->last_unoccupied_room] = i;
+        }
+    }
+}
+
+static int resize(prrte_hotel_t *h, int num_rooms)
+{
+    prrte_hotel_room_t *rooms;
+    int *unoccupied, i;
+
+    rooms = (prrte_hotel_room_t*)realloc(h->rooms, num_rooms * sizeof(prrte_hotel_room_t));
+    if (NULL == rooms) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    h->rooms = rooms;
+    unoccupied = (int*)realloc(h->unoccupied_rooms, num_rooms * sizeof(int));
+    if (NULL == unoccupied) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    h->unoccupied_rooms = unoccupied;
+
+    for (i = h->num_rooms; i < num_rooms; i++) {
+        h->rooms[i].occupant = NULL;
+        h->rooms[i].next = -1;
+        h->rooms[i].prev = -1;
+    }
+    h->num_rooms = num_rooms;
+    reset_unoccupied(h);
+    return PRRTE_SUCCESS;
+}
+
+int prrte_hotel_grow(prrte_hotel_t *h)
 {
-    prrte_hotel_room_eviction_callback_arg_t *eargs =
-        (prrte_hotel_room_eviction_callback_arg_t*) arg;
-    void *occupant = eargs->hotel->rooms[eargs->room_num].occupant;
-
-    /* Remove the occupant from the room.
-
-       Do not change this logic without also changing the same logic
-       in prrte_hotel_checkout() and
-       prrte_hotel_checkout_and_return_occupant(). */
-    prrte_hotel_t *hotel = eargs->hotel;
-    prrte_hotel_room_t *room = &(hotel->rooms[eargs->room_num]);
-    room->occupant = NULL;
-    hotel->last_unoccupied_room++;
-    assert(hotel->last_unoccupied_room < hotel->num_rooms);
-    hotel->unoccupied_rooms[hotel->last_unoccupied_room] = eargs->room_num;
-
-    /* Invoke the user callback to tell them that they were evicted */
-    hotel->evict_callback_fn(hotel,
-                             eargs->room_num,
-                             occupant);
+    int num_rooms;
+
+    if (0 < h->max_rooms && h->num_rooms >= h->max_rooms) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    num_rooms = 2 * h->num_rooms;
+    if (0 < h->max_rooms && num_rooms > h->max_rooms) {
+        num_rooms = h->max_rooms;
+    }
+    /* all rooms are occupied, so the free list simply becomes
+     * the new rooms */
+    return resize(h, num_rooms);
+}
+
+/* Close the top half of the hotel if it is lightly used and
+ * nobody is staying up there */
+static void shrink(prrte_hotel_t *h)
+{
+    int occupied, num_rooms, i;
+
+    if (h->num_rooms <= h->min_rooms) {
+        return;
+    }
+    occupied = h->num_rooms - (h->last_unoccupied_room + 1);
+    if (occupied >= h->num_rooms / 4) {
+        return;
+    }
+    num_rooms = h->num_rooms / 2;
+    if (num_rooms < h->min_rooms) {
+        num_rooms = h->min_rooms;
+    }
+    for (i = num_rooms; i < h->num_rooms; i++) {
+        if (NULL != h->rooms[i].occupant) {
+            return;
+        }
+    }
+    (void)resize(h, num_rooms);
+}
+
+void prrte_hotel_start_wheel(prrte_hotel_t *h)
+{
+    struct timeval tv = {PRRTE_HOTEL_TICK_SEC, 0};
+
+    h->wheel_active = true;
+    prrte_event_evtimer_add(&h->wheel_event, &tv);
+}
+
+static void wheel_tick(int fd, short flags, void *arg)
+{
+    prrte_hotel_t *hotel = (prrte_hotel_t*)arg;
+    hotel_guest_t *due = NULL;
+    int ndue = 0, ndone, room_num, next;
+    int slot;
+
+    hotel->wheel_active = false;
+    hotel->tick++;
+    slot = hotel->tick & (PRRTE_HOTEL_WHEEL_SLOTS - 1);
+
+    /* collect everyone whose stay is up - the eviction callback may
+     * check people in or out, so we cannot walk the slot while
+     * invoking it */
+    for (room_num = hotel->wheel[slot]; 0 <= room_num; room_num = hotel->rooms[room_num].next) {
+        if ((int32_t)(hotel->rooms[room_num].expire - hotel->tick) <= 0) {
+            ++ndue;
+        }
+    }
+    if (0 < ndue) {
+        due = (hotel_guest_t*)malloc(ndue * sizeof(hotel_guest_t));
+        ndue = 0;
+        if (NULL != due) {
+            for (room_num = hotel->wheel[slot]; 0 <= room_num; room_num = next) {
+                next = hotel->rooms[room_num].next;
+                if ((int32_t)(hotel->rooms[room_num].expire - hotel->tick) <= 0) {
+                    due[ndue].room_num = room_num;
+                    due[ndue].occupant = hotel->rooms[room_num].occupant;
+                    ++ndue;
+                }
+            }
+        }
+    }
+
+    for (ndone = 0; ndone < ndue; ndone++) {
+        room_num = due[ndone].room_num;
+        /* a previous callback may already have checked them out */
+        if (room_num >= hotel->num_rooms ||
+            hotel->rooms[room_num].occupant != due[ndone].occupant ||
+            0 < (int32_t)(hotel->rooms[room_num].expire - hotel->tick)) {
+            continue;
+        }
+        /* Remove the occupant from the room.
+
+           Do not change this logic without also changing the same logic
+           in prrte_hotel_checkout() and
+           prrte_hotel_checkout_and_return_occupant(). */
+        hotel->rooms[room_num].occupant = NULL;
+        prrte_hotel_wheel_remove(hotel, room_num);
+        hotel->last_unoccupied_room++;
+        assert(hotel->last_unoccupied_room < hotel->num_rooms);
+        hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
+
+        /* Invoke the user callback to tell them that they were evicted */
+        hotel->evict_callback_fn(hotel, room_num, due[ndone].occupant);
+    }
+    if (NULL != due) {
+        free(due);
+    }
+
+    shrink(hotel);
+
+    /* keep turning while anyone is staying with us */
+    if (!hotel->wheel_active && !prrte_hotel_is_empty(hotel)) {
+        prrte_hotel_start_wheel(hotel);
+    }
 }
 
 
@@ -59,77 +202,79 @@ int prrte_hotel_init(prrte_hotel_t *h, int num_rooms,
     }
 
     h->num_rooms = num_rooms;
+    h->min_rooms = num_rooms;
+    h->max_rooms = num_rooms;
     h->evbase = evbase;
     h->eviction_timeout.tv_usec = 0;
     h->eviction_timeout.tv_sec = eviction_timeout;
     h->evict_callback_fn = evict_callback_fn;
+    /* the next tick may be due at any moment, so allow one more
+     * to ensure every guest gets their full stay */
+    h->timeout_ticks = (eviction_timeout + PRRTE_HOTEL_TICK_SEC - 1) / PRRTE_HOTEL_TICK_SEC + 1;
     h->rooms = (prrte_hotel_room_t*)malloc(num_rooms * sizeof(prrte_hotel_room_t));
-    if (NULL != evict_callback_fn) {
-        h->eviction_args =
-            (prrte_hotel_room_eviction_callback_arg_t*)malloc(num_rooms * sizeof(prrte_hotel_room_eviction_callback_arg_t));
-    }
     h->unoccupied_rooms = (int*) malloc(num_rooms * sizeof(int));
-    h->last_unoccupied_room = num_rooms - 1;
+    if (NULL == h->rooms || NULL == h->unoccupied_rooms) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
 
     for (i = 0; i < num_rooms; ++i) {
         /* Mark this room as unoccupied */
         h->rooms[i].occupant = NULL;
+        h->rooms[i].next = -1;
+        h->rooms[i].prev = -1;
+    }
+    /* Setup the unoccupied index array */
+    reset_unoccupied(h);
 
-        /* Setup this room in the unoccupied index array */
-        h->unoccupied_rooms[i] = i;
-
-        /* Setup the eviction callback args */
-        h->eviction_args[i].hotel = h;
-        h->eviction_args[i].room_num = i;
-
-        /* Create this room's event (but don't add it) */
-        if (NULL != h->evbase) {
-            prrte_event_set(h->evbase,
-                           &(h->rooms[i].eviction_timer_event),
-                           -1, 0, local_eviction_callback,
-                           &(h->eviction_args[i]));
+    for (i = 0; i < PRRTE_HOTEL_WHEEL_SLOTS; i++) {
+        h->wheel[i] = -1;
+    }
 
-            /* Set the priority so it gets serviced properly */
-            prrte_event_set_priority(&(h->rooms[i].eviction_timer_event),
-                                    eviction_event_priority);
-        }
+    /* Create the wheel's event (but don't add it) */
+    if (NULL != h->evbase) {
+        prrte_event_evtimer_set(h->evbase, &h->wheel_event, wheel_tick, h);
+        /* Set the priority so it gets serviced properly */
+        prrte_event_set_priority(&h->wheel_event, eviction_event_priority);
     }
 
     return PRRTE_SUCCESS;
 }
 
+void prrte_hotel_set_max_rooms(prrte_hotel_t *h, int max_rooms)
+{
+    if (0 < max_rooms && max_rooms < h->num_rooms) {
+        max_rooms = h->num_rooms;
+    }
+    h->max_rooms = max_rooms;
+}
+
 static void constructor(prrte_hotel_t *h)
 {
     h->num_rooms = 0;
+    h->min_rooms = 0;
+    h->max_rooms = 0;
     h->evbase = NULL;
     h->eviction_timeout.tv_sec = 0;
     h->eviction_timeout.tv_usec = 0;
     h->evict_callback_fn = NULL;
     h->rooms = NULL;
-    h->eviction_args = NULL;
     h->unoccupied_rooms = NULL;
     h->last_unoccupied_room = -1;
+    h->wheel_active = false;
+    h->tick = 0;
+    h->timeout_ticks = 0;
 }
 
 static void destructor(prrte_hotel_t *h)
 {
-    int i;
-
-    /* Go through all occupied rooms and destroy their events */
-    if (NULL != h->evbase) {
-        for (i = 0; i < h->num_rooms; ++i) {
-            if (NULL != h->rooms[i].occupant) {
-                prrte_event_del(&(h->rooms[i].eviction_timer_event));
-            }
-        }
+    /* Stop the wheel */
+    if (NULL != h->evbase && h->wheel_active) {
+        prrte_event_evtimer_del(&h->wheel_event);
     }
 
     if (NULL != h->rooms) {
         free(h->rooms);
     }
-    if (NULL != h->eviction_args) {
-        free(h->eviction_args);
-    }
     if (NULL != h->unoccupied_rooms) {
         free(h->unoccupied_rooms);
     }
@@ -13,14 +13,18 @@
  *
  * This file provides a "hotel" class:
  *
- * - A hotel has a fixed number of rooms (i.e., storage slots)
+ * - A hotel has a number of rooms (i.e., storage slots)
  * - An arbitrary data pointer can check into an empty room at any time
  * - The occupant of a room can check out at any time
  * - Optionally, the occupant of a room can be forcibly evicted at a
- *   given time (i.e., when an prrte timer event expires).
+ *   given time. All rooms share a single timer wheel that ticks once
+ *   a second, so a stay lasts between the eviction timeout and one
+ *   second more than that.
  * - The hotel has finite occupancy; if you try to checkin a new
  *   occupant and the hotel is already full, it will gracefully fail
- *   to checkin.
+ *   to checkin. The hotel can optionally be allowed to add rooms
+ *   when it fills, up to a given maximum, and will give them back
+ *   once they are no longer needed.
  *
  * One use case for this class is for ACK-based network retransmission
  * schemes (NACK-based retransmission schemes probably can use
@@ -43,8 +47,8 @@
  *
  * There is an prrte_hotel_init() function to create a hotel, but no
  * corresponding finalize; the destructor will handle all finalization
- * issues.  Note that when a hotel is destroyed, it will delete all
- * pending events from the event base (i.e., all pending eviction
+ * issues.  Note that when a hotel is destroyed, it will delete its
+ * pending timer event from the event base (i.e., all pending eviction
  * callbacks); no further eviction callbacks will be invoked.
  */
 
@@ -66,6 +70,9 @@ typedef void (*prrte_hotel_eviction_callback_fn_t)(struct prrte_hotel_t *hotel,
                                                   int room_num,
                                                   void *occupant);
 
+/* number of slots in the eviction timer wheel - must be a power of 2 */
+#define PRRTE_HOTEL_WHEEL_SLOTS  64
+
 /* Note that this is an internal data structure; it is not part of the
    public prrte_hotel interface.  Public consumers of prrte_hotel
    shouldn't need to use this struct at all (we only have it here in
@@ -75,41 +82,27 @@ typedef void (*prrte_hotel_eviction_callback_fn_t)(struct prrte_hotel_t *hotel,
    The room struct should be as small as possible to be cache
    friendly.  Specifically: it would be great if multiple rooms could
    fit in a single cache line because we'll always allocate a
-   contiguous set of rooms in an array. */
+   contiguous set of rooms in an array. Rooms are linked by index
+   into the timer wheel slot of the tick at which they expire, so
+   the array can be resized without disturbing the wheel. */
 typedef struct {
     void *occupant;
-    prrte_event_t eviction_timer_event;
+    uint32_t expire;
+    int next;
+    int prev;
 } prrte_hotel_room_t;
 
-/* Note that this is an internal data structure; it is not part of the
-   public prrte_hotel interface.  Public consumers of prrte_hotel
-   shouldn't need to use this struct at all (we only have it here in
-   this .h file because some functions are inlined for speed, and need
-   to get to the internals of this struct).
-
-   Use a unique struct for holding the arguments for eviction
-   callbacks.  We *could* make the to-be-evicted prrte_hotel_room_t
-   instance as the argument, but we don't, for 2 reasons:
-
-   1. We want as many prrte_hotel_room_t's to fit in a cache line as
-      possible (i.e., to be as cache-friendly as possible).  The
-      common/fast code path only needs to access the data in the
-      prrte_hotel_room_t (and not the callback argument data).
-
-   2. Evictions will be uncommon, so we don't mind penalizing them a
-      bit by making the data be in a separate cache line.
-*/
-typedef struct {
-    struct prrte_hotel_t *hotel;
-    int room_num;
-} prrte_hotel_room_eviction_callback_arg_t;
-
 typedef struct prrte_hotel_t {
     /* make this an object */
     prrte_object_t super;
 
-    /* Max number of rooms in the hotel */
+    /* Current number of rooms in the hotel */
     int num_rooms;
+    /* Number of rooms the hotel was opened with - it never
+     * shrinks below this */
+    int min_rooms;
+    /* Max number of rooms the hotel can grow to (0 => no limit) */
+    int max_rooms;
 
     /* event base to be used for eviction timeout */
     prrte_event_base_t *evbase;
@@ -119,14 +112,19 @@ typedef struct prrte_hotel_t {
     /* All rooms in this hotel */
     prrte_hotel_room_t *rooms;
 
-    /* Separate array for all the eviction callback arguments (see
-       rationale above for why this is a separate array) */
-    prrte_hotel_room_eviction_callback_arg_t *eviction_args;
-
-    /* All currently unoccupied rooms in this hotel (not necessarily
-       in any particular order) */
+    /* All currently unoccupied rooms in this hotel - the lowest
+       numbered rooms are handed out first so that the top of the
+       hotel empties out and can be closed */
     int *unoccupied_rooms;
     int last_unoccupied_room;
+
+    /* eviction timer wheel - each slot heads a list of the rooms
+       that expire on a tick that maps to it */
+    prrte_event_t wheel_event;
+    bool wheel_active;
+    uint32_t tick;
+    uint32_t timeout_ticks;
+    int wheel[PRRTE_HOTEL_WHEEL_SLOTS];
 } prrte_hotel_t;
 PRRTE_CLASS_DECLARATION(prrte_hotel_t);
 
@@ -151,6 +149,9 @@ PRRTE_CLASS_DECLARATION(prrte_hotel_t);
  * already been ("forcibly") checked out *before* the
  * eviction_callback_fn is invoked.
  *
+ * The hotel does not grow unless prrte_hotel_set_max_rooms() is
+ * called after this function.
+ *
  * @return PRRTE_SUCCESS if all initializations were succesful. Otherwise,
  *  the error indicate what went wrong in the function.
  */
@@ -160,6 +161,62 @@ PRRTE_EXPORT int prrte_hotel_init(prrte_hotel_t *hotel, int num_rooms,
                                   int eviction_event_priority,
                                   prrte_hotel_eviction_callback_fn_t evict_callback_fn);
 
+/**
+ * Allow the hotel to grow when it is full.
+ *
+ * @param hotel Pointer to a hotel (IN)
+ * @param max_rooms Max number of rooms the hotel may grow to, or 0
+ * for no limit (IN)
+ *
+ * The hotel doubles in size each time it fills, up to max_rooms.
+ * Rooms added this way are closed again once occupancy drops and
+ * the top of the hotel has emptied out. Room numbers that are still
+ * occupied are never affected.
+ */
+PRRTE_EXPORT void prrte_hotel_set_max_rooms(prrte_hotel_t *hotel, int max_rooms);
+
+/* Internal: add rooms to a full hotel */
+PRRTE_EXPORT int prrte_hotel_grow(prrte_hotel_t *hotel);
+
+/* Internal: start the wheel turning */
+PRRTE_EXPORT void prrte_hotel_start_wheel(prrte_hotel_t *hotel);
+
+/* Internal: put a newly occupied room on the wheel */
+static inline void prrte_hotel_wheel_add(prrte_hotel_t *hotel, int room_num)
+{
+    prrte_hotel_room_t *room = &(hotel->rooms[room_num]);
+    int slot;
+
+    room->expire = hotel->tick + hotel->timeout_ticks;
+    slot = room->expire & (PRRTE_HOTEL_WHEEL_SLOTS - 1);
+    room->prev = -1;
+    room->next = hotel->wheel[slot];
+    if (0 <= room->next) {
+        hotel->rooms[room->next].prev = room_num;
+    }
+    hotel->wheel[slot] = room_num;
+    if (!hotel->wheel_active) {
+        prrte_hotel_start_wheel(hotel);
+    }
+}
+
+/* Internal: take a room off the wheel */
+static inline void prrte_hotel_wheel_remove(prrte_hotel_t *hotel, int room_num)
+{
+    prrte_hotel_room_t *room = &(hotel->rooms[room_num]);
+
+    if (0 <= room->prev) {
+        hotel->rooms[room->prev].next = room->next;
+    } else {
+        hotel->wheel[room->expire & (PRRTE_HOTEL_WHEEL_SLOTS - 1)] = room->next;
+    }
+    if (0 <= room->next) {
+        hotel->rooms[room->next].prev = room->prev;
+    }
+    room->next = -1;
+    room->prev = -1;
+}
+
 /**
  * Check in an occupant to the hotel.
  *
@@ -188,7 +245,9 @@ static inline int prrte_hotel_checkin(prrte_hotel_t *hotel,
 
     /* Do we have any rooms available? */
     if (PRRTE_UNLIKELY(hotel->last_unoccupied_room < 0)) {
-        return PRRTE_ERR_OUT_OF_RESOURCE;
+        if (PRRTE_SUCCESS != prrte_hotel_grow(hotel)) {
+            return PRRTE_ERR_OUT_OF_RESOURCE;
+        }
     }
 
     /* Put this occupant into the first empty room that we have */
@@ -196,10 +255,9 @@ static inline int prrte_hotel_checkin(prrte_hotel_t *hotel,
     room = &(hotel->rooms[*room_num]);
     room->occupant = occupant;
 
-    /* Assign the event and make it pending */
+    /* Put it on the wheel */
     if (NULL != hotel->evbase) {
-        prrte_event_add(&(room->eviction_timer_event),
-                       &(hotel->eviction_timeout));
+        prrte_hotel_wheel_add(hotel, *room_num);
     }
 
     return PRRTE_SUCCESS;
@@ -221,10 +279,9 @@ static inline void prrte_hotel_checkin_with_res(prrte_hotel_t *hotel,
     assert(room->occupant == NULL);
     room->occupant = occupant;
 
-    /* Assign the event and make it pending */
+    /* Put it on the wheel */
     if (NULL != hotel->evbase) {
-        prrte_event_add(&(room->eviction_timer_event),
-                       &(hotel->eviction_timeout));
+        prrte_hotel_wheel_add(hotel, *room_num);
     }
 }
 
@@ -235,7 +292,8 @@ static inline void prrte_hotel_checkin_with_res(prrte_hotel_t *hotel,
  * @param room Room number to checkout (IN)
  *
  * If there is an occupant in the room, their timer is canceled and
- * they are checked out.
+ * they are checked out. Room numbers that are not (or no longer)
+ * part of the hotel are ignored.
  *
  * Nothing is returned (as a minor optimization).
  */
@@ -243,18 +301,20 @@ static inline void prrte_hotel_checkout(prrte_hotel_t *hotel, int room_num)
 {
     prrte_hotel_room_t *room;
 
-    /* Bozo check */
-    assert(room_num < hotel->num_rooms);
+    /* Bozo check - the room may have been closed */
+    if (PRRTE_UNLIKELY(room_num < 0 || room_num >= hotel->num_rooms)) {
+        return;
+    }
 
     /* If there's an occupant in the room, check them out */
     room = &(hotel->rooms[room_num]);
     if (PRRTE_LIKELY(NULL != room->occupant)) {
         /* Do not change this logic without also changing the same
            logic in prrte_hotel_checkout_and_return_occupant() and
-           prrte_hotel.c:local_eviction_callback(). */
+           prrte_hotel.c:wheel_tick(). */
         room->occupant = NULL;
         if (NULL != hotel->evbase) {
-            prrte_event_del(&(room->eviction_timer_event));
+            prrte_hotel_wheel_remove(hotel, room_num);
         }
         hotel->last_unoccupied_room++;
         assert(hotel->last_unoccupied_room < hotel->num_rooms);
@@ -281,27 +341,28 @@ static inline void prrte_hotel_checkout_and_return_occupant(prrte_hotel_t *hotel
 {
     prrte_hotel_room_t *room;
 
-    /* Bozo check */
-    assert(room_num < hotel->num_rooms);
+    *occupant = NULL;
+
+    /* Bozo check - the room may have been closed */
+    if (PRRTE_UNLIKELY(room_num < 0 || room_num >= hotel->num_rooms)) {
+        return;
+    }
 
     /* If there's an occupant in the room, check them out */
     room = &(hotel->rooms[room_num]);
     if (PRRTE_LIKELY(NULL != room->occupant)) {
         /* Do not change this logic without also changing the same
            logic in prrte_hotel_checkout() and
-           prrte_hotel.c:local_eviction_callback(). */
+           prrte_hotel.c:wheel_tick(). */
         *occupant = room->occupant;
         room->occupant = NULL;
         if (NULL != hotel->evbase) {
-            prrte_event_del(&(room->eviction_timer_event));
+            prrte_hotel_wheel_remove(hotel, room_num);
         }
         hotel->last_unoccupied_room++;
         assert(hotel->last_unoccupied_room < hotel->num_rooms);
         hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
     }
-    else {
-        *occupant = NULL;
-    }
 }
 
 /**
@@ -332,11 +393,13 @@ static inline void prrte_hotel_knock(prrte_hotel_t *hotel, int room_num, void **
 {
     prrte_hotel_room_t *room;
 
-    /* Bozo check */
-    assert(room_num < hotel->num_rooms);
-
     *occupant = NULL;
 
+    /* Bozo check - the room may have been closed */
+    if (PRRTE_UNLIKELY(room_num < 0 || room_num >= hotel->num_rooms)) {
+        return;
+    }
+
     /* If there's an occupant in the room, have them come to the door */
     room = &(hotel->rooms[room_num]);
     if (PRRTE_LIKELY(NULL != room->occupant)) {
@@ -43,6 +43,8 @@ PRRTE_CLASS_INSTANCE(prrte_ring_buffer_t, prrte_object_t,
 static void prrte_ring_buffer_construct(prrte_ring_buffer_t *ring)
 {
     PRRTE_CONSTRUCT_LOCK(&ring->lock);
+    /* the lock guards access - it starts out available */
+    ring->lock.active = false;
     ring->in_use = false;
     ring->head = 0;
     ring->tail = -1;
@@ -32,6 +32,7 @@
   #endif
 #endif
 
+#include "src/class/prrte_hash_table.h"
 #include "src/class/prrte_list.h"
 #include "src/class/prrte_value_array.h"
 #include "src/dss/dss_types.h"
@@ -133,6 +134,9 @@ typedef struct {
     prrte_object_t super;
     hwloc_cpuset_t available;
     prrte_list_t summaries;
+    /* renderings of cpusets on this topology, keyed by the
+     * cpuset's list string - created on first use */
+    prrte_hash_table_t *cpuset_memo;
 
     /** \brief Additional space for custom data */
     void *userdata;
@@ -431,7 +435,7 @@ PRRTE_EXPORT int prrte_hwloc_print(char **output, char *prefix,
  */
 PRRTE_EXPORT int prrte_hwloc_base_cset2str(char *str, int len,
                                            hwloc_topology_t topo,
-                                           hwloc_cpuset_t cpuset);
+                                           hwloc_const_cpuset_t cpuset);
 
 /**
  * Make a prettyprint string for a cset in a map format.
@@ -443,7 +447,7 @@ PRRTE_EXPORT int prrte_hwloc_base_cset2str(char *str, int len,
  */
 PRRTE_EXPORT int prrte_hwloc_base_cset2mapstr(char *str, int len,
                                               hwloc_topology_t topo,
-                                              hwloc_cpuset_t cpuset);
+                                              hwloc_const_cpuset_t cpuset);
 
 /* get the hwloc object that corresponds to the given processor id  and type */
 PRRTE_EXPORT hwloc_obj_t prrte_hwloc_base_get_pu(hwloc_topology_t topo,
@@ -455,9 +459,19 @@ PRRTE_EXPORT hwloc_obj_t prrte_hwloc_base_get_pu(hwloc_topology_t topo,
 PRRTE_EXPORT char* prrte_hwloc_base_get_topo_signature(hwloc_topology_t topo);
 
 
-/* get a string describing the locality of a given process */
+/* get a string describing the locality of a given process - caller
+ * is responsible for freeing the returned string */
 PRRTE_EXPORT char* prrte_hwloc_base_get_locality_string(hwloc_topology_t topo, char *bitmap);
 
+/* get the cpuset described by a cpu bitmap string. The string is only
+ * parsed the first time it is seen on the given topology - the caller
+ * is responsible for freeing the returned copy with hwloc_bitmap_free.
+ * Returns NULL if the topology has not been filtered */
+PRRTE_EXPORT hwloc_cpuset_t prrte_hwloc_base_get_cpuset(hwloc_topology_t topo, char *bitmap);
+
+/* release all cached cpuset renderings held by a topology */
+PRRTE_EXPORT void prrte_hwloc_base_flush_cpuset_memo(prrte_hwloc_topo_data_t *sum);
+
 /* extract a location from the locality string */
 PRRTE_EXPORT char* prrte_hwloc_base_get_location(char *locality,
                                                  hwloc_obj_type_t type,
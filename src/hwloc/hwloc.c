@@ -423,6 +423,7 @@ static void topo_data_const(prrte_hwloc_topo_data_t *ptr)
 {
     ptr->available = NULL;
     PRRTE_CONSTRUCT(&ptr->summaries, prrte_list_t);
+    ptr->cpuset_memo = NULL;
     ptr->userdata = NULL;
 }
 static void topo_data_dest(prrte_hwloc_topo_data_t *ptr)
@@ -436,6 +437,10 @@ static void topo_data_dest(prrte_hwloc_topo_data_t *ptr)
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&ptr->summaries);
+    if (NULL != ptr->cpuset_memo) {
+        prrte_hwloc_base_flush_cpuset_memo(ptr);
+        PRRTE_RELEASE(ptr->cpuset_memo);
+    }
     ptr->userdata = NULL;
 }
 PRRTE_CLASS_INSTANCE(prrte_hwloc_topo_data_t,
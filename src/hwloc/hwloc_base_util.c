@@ -1513,7 +1513,7 @@ static char *bitmap2rangestr(int bitmap)
  * Make a map of socket/core/hwthread tuples
  */
 static int build_map(int *num_sockets_arg, int *num_cores_arg,
-                     hwloc_cpuset_t cpuset, int ***map, hwloc_topology_t topo)
+                     hwloc_const_cpuset_t cpuset, int ***map, hwloc_topology_t topo)
 {
     int num_sockets, num_cores;
     int socket_index, core_index, pu_index;
@@ -1591,9 +1591,9 @@ static int build_map(int *num_sockets_arg, int *num_cores_arg,
 /*
  * Make a prettyprint string for a hwloc_cpuset_t
  */
-int prrte_hwloc_base_cset2str(char *str, int len,
-                             hwloc_topology_t topo,
-                             hwloc_cpuset_t cpuset)
+static int cset2str(char *str, int len,
+                    hwloc_topology_t topo,
+                    hwloc_const_cpuset_t cpuset)
 {
     bool first;
     int num_sockets, num_cores;
@@ -1757,9 +1757,9 @@ static hwloc_obj_type_t first_type_under_a_numa(hwloc_topology_t topo)
  *        B - signifies PU a process is bound to
  *        ~ - signifies PU that is disallowed, eg not in our cgroup:
  */
-int prrte_hwloc_base_cset2mapstr(char *str, int len,
-                                hwloc_topology_t topo,
-                                hwloc_cpuset_t cpuset)
+static int cset2mapstr(char *str, int len,
+                       hwloc_topology_t topo,
+                       hwloc_const_cpuset_t cpuset)
 {
     char tmp[BUFSIZ];
     int core_index, pu_index;
@@ -2193,7 +2193,7 @@ char* prrte_hwloc_base_get_topo_signature(hwloc_topology_t topo)
 
 static int prrte_hwloc_base_get_locality_string_by_depth(hwloc_topology_t topo,
                                                          int d,
-                                                         hwloc_cpuset_t cpuset,
+                                                         hwloc_const_cpuset_t cpuset,
                                                          hwloc_cpuset_t result)
 {
     hwloc_obj_t obj;
@@ -2220,24 +2220,17 @@ static int prrte_hwloc_base_get_locality_string_by_depth(hwloc_topology_t topo,
     return 0;
 }
 
-char* prrte_hwloc_base_get_locality_string(hwloc_topology_t topo,
-                                          char *bitmap)
+static char* locality_string(hwloc_topology_t topo,
+                             hwloc_const_cpuset_t cpuset)
 {
     char *locality=NULL, *tmp, *t2;
     unsigned depth, d;
-    hwloc_cpuset_t cpuset, result;
+    hwloc_cpuset_t result;
     hwloc_obj_type_t type;
 
     /* if this proc is not bound, then there is no locality. We
-     * know it isn't bound if the cpuset is NULL, or if it is
-     * all 1's */
-    if (NULL == bitmap) {
-        return NULL;
-    }
-    cpuset = hwloc_bitmap_alloc();
-    hwloc_bitmap_list_sscanf(cpuset, bitmap);
+     * know it isn't bound if the cpuset is all 1's */
     if (hwloc_bitmap_isfull(cpuset)) {
-        hwloc_bitmap_free(cpuset);
         return NULL;
     }
 
@@ -2382,7 +2375,6 @@ char* prrte_hwloc_base_get_locality_string(hwloc_topology_t topo,
 #endif
 
     hwloc_bitmap_free(result);
-    hwloc_bitmap_free(cpuset);
 
     /* remove the trailing colon */
     if (NULL != locality) {
@@ -2391,6 +2383,228 @@ char* prrte_hwloc_base_get_locality_string(hwloc_topology_t topo,
     return locality;
 }
 
+/* Most procs on a node share a small number of distinct cpusets (e.g.,
+ * one per core or socket), so cache the strings we generate for each
+ * cpuset on the topology's root data instead of walking the topology
+ * every time one is requested */
+#define PRRTE_HWLOC_CPUSET_MEMO_MAX 1024
+
+typedef struct {
+    prrte_object_t super;
+    hwloc_cpuset_t cpuset;
+    bool locality_done;
+    char *locality;
+    /* the renderings are generated into a caller-sized buffer,
+     * so track the size each was generated with */
+    int cset2str_rc;
+    int cset2str_len;
+    char *cset2str;
+    int mapstr_rc;
+    int mapstr_len;
+    char *mapstr;
+} prrte_hwloc_cpuset_memo_t;
+static void memo_con(prrte_hwloc_cpuset_memo_t *p)
+{
+    p->cpuset = NULL;
+    p->locality_done = false;
+    p->locality = NULL;
+    p->cset2str_rc = PRRTE_SUCCESS;
+    p->cset2str_len = 0;
+    p->cset2str = NULL;
+    p->mapstr_rc = PRRTE_SUCCESS;
+    p->mapstr_len = 0;
+    p->mapstr = NULL;
+}
+static void memo_des(prrte_hwloc_cpuset_memo_t *p)
+{
+    if (NULL != p->cpuset) {
+        hwloc_bitmap_free(p->cpuset);
+    }
+    if (NULL != p->locality) {
+        free(p->locality);
+    }
+    if (NULL != p->cset2str) {
+        free(p->cset2str);
+    }
+    if (NULL != p->mapstr) {
+        free(p->mapstr);
+    }
+}
+static PRRTE_CLASS_INSTANCE(prrte_hwloc_cpuset_memo_t,
+                            prrte_object_t,
+                            memo_con, memo_des);
+
+void prrte_hwloc_base_flush_cpuset_memo(prrte_hwloc_topo_data_t *sum)
+{
+    void *key, *node;
+    size_t keylen;
+    prrte_hwloc_cpuset_memo_t *memo;
+    int rc;
+
+    if (NULL == sum->cpuset_memo) {
+        return;
+    }
+    rc = prrte_hash_table_get_first_key_ptr(sum->cpuset_memo, &key, &keylen,
+                                            (void**)&memo, &node);
+    while (PRRTE_SUCCESS == rc) {
+        PRRTE_RELEASE(memo);
+        rc = prrte_hash_table_get_next_key_ptr(sum->cpuset_memo, &key, &keylen,
+                                               (void**)&memo, node, &node);
+    }
+    prrte_hash_table_remove_all(sum->cpuset_memo);
+}
+
+/* find the memo for a cpuset, given either its list string or the
+ * cpuset itself, creating it if necessary. Returns NULL if the
+ * topology has not been setup for caching */
+static prrte_hwloc_cpuset_memo_t* get_memo(hwloc_topology_t topo,
+                                          char *bitmap,
+                                          hwloc_const_cpuset_t cpuset)
+{
+    hwloc_obj_t root;
+    prrte_hwloc_topo_data_t *sum;
+    prrte_hwloc_cpuset_memo_t *memo;
+    char *key = bitmap;
+
+    root = hwloc_get_root_obj(topo);
+    if (NULL == root || NULL == root->userdata) {
+        return NULL;
+    }
+    sum = (prrte_hwloc_topo_data_t*)root->userdata;
+    if (NULL == sum->available) {
+        /* the topology hasn't been filtered yet */
+        return NULL;
+    }
+    if (NULL == sum->cpuset_memo) {
+        sum->cpuset_memo = PRRTE_NEW(prrte_hash_table_t);
+        prrte_hash_table_init(sum->cpuset_memo, 64);
+    }
+
+    if (NULL == key) {
+        if (0 > hwloc_bitmap_list_asprintf(&key, cpuset)) {
+            return NULL;
+        }
+    }
+    memo = NULL;
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(sum->cpuset_memo, key,
+                                                        strlen(key), (void**)&memo)) {
+        goto done;
+    }
+
+    /* don't let the cache grow without bound */
+    if (PRRTE_HWLOC_CPUSET_MEMO_MAX <= prrte_hash_table_get_size(sum->cpuset_memo)) {
+        prrte_hwloc_base_flush_cpuset_memo(sum);
+    }
+    memo = PRRTE_NEW(prrte_hwloc_cpuset_memo_t);
+    if (NULL != cpuset) {
+        memo->cpuset = hwloc_bitmap_dup(cpuset);
+    } else {
+        memo->cpuset = hwloc_bitmap_alloc();
+        hwloc_bitmap_list_sscanf(memo->cpuset, key);
+    }
+    prrte_hash_table_set_value_ptr(sum->cpuset_memo, key, strlen(key), memo);
+
+  done:
+    if (key != bitmap) {
+        free(key);
+    }
+    return memo;
+}
+
+/* copy a cached rendering into the caller's buffer, regenerating it
+ * if it was truncated by a smaller buffer than the caller's */
+static int memo_render(char *str, int len,
+                       hwloc_topology_t topo,
+                       hwloc_const_cpuset_t cpuset,
+                       int (*fn)(char*, int, hwloc_topology_t, hwloc_const_cpuset_t),
+                       char **cache, int *cachelen, int *cacherc)
+{
+    if (NULL == *cache ||
+        (len > *cachelen && (int)strlen(*cache) == *cachelen - 1)) {
+        if (NULL != *cache) {
+            free(*cache);
+        }
+        *cache = (char*)malloc(len);
+        if (NULL == *cache) {
+            return fn(str, len, topo, cpuset);
+        }
+        (*cache)[0] = '\0';
+        *cacherc = fn(*cache, len, topo, cpuset);
+        *cachelen = len;
+    }
+    str[0] = '\0';
+    if (PRRTE_SUCCESS == *cacherc) {
+        strncat(str, *cache, len - 1);
+    }
+    return *cacherc;
+}
+
+int prrte_hwloc_base_cset2str(char *str, int len,
+                             hwloc_topology_t topo,
+                             hwloc_const_cpuset_t cpuset)
+{
+    prrte_hwloc_cpuset_memo_t *memo;
+
+    if (NULL == (memo = get_memo(topo, NULL, cpuset))) {
+        return cset2str(str, len, topo, cpuset);
+    }
+    return memo_render(str, len, topo, memo->cpuset, cset2str,
+                       &memo->cset2str, &memo->cset2str_len, &memo->cset2str_rc);
+}
+
+int prrte_hwloc_base_cset2mapstr(char *str, int len,
+                                hwloc_topology_t topo,
+                                hwloc_const_cpuset_t cpuset)
+{
+    prrte_hwloc_cpuset_memo_t *memo;
+
+    if (NULL == (memo = get_memo(topo, NULL, cpuset))) {
+        return cset2mapstr(str, len, topo, cpuset);
+    }
+    return memo_render(str, len, topo, memo->cpuset, cset2mapstr,
+                       &memo->mapstr, &memo->mapstr_len, &memo->mapstr_rc);
+}
+
+hwloc_cpuset_t prrte_hwloc_base_get_cpuset(hwloc_topology_t topo, char *bitmap)
+{
+    prrte_hwloc_cpuset_memo_t *memo;
+
+    if (NULL == bitmap || NULL == (memo = get_memo(topo, bitmap, NULL))) {
+        return NULL;
+    }
+    /* hand back a copy - the memo can be flushed by any later
+     * miss while the caller still holds the cpuset */
+    return hwloc_bitmap_dup(memo->cpuset);
+}
+
+char* prrte_hwloc_base_get_locality_string(hwloc_topology_t topo,
+                                          char *bitmap)
+{
+    prrte_hwloc_cpuset_memo_t *memo;
+    hwloc_cpuset_t cpuset;
+    char *locality;
+
+    /* if this proc is not bound, then there is no locality */
+    if (NULL == bitmap) {
+        return NULL;
+    }
+    if (NULL == (memo = get_memo(topo, bitmap, NULL))) {
+        cpuset = hwloc_bitmap_alloc();
+        hwloc_bitmap_list_sscanf(cpuset, bitmap);
+        locality = locality_string(topo, cpuset);
+        hwloc_bitmap_free(cpuset);
+        return locality;
+    }
+    if (!memo->locality_done) {
+        memo->locality = locality_string(topo, memo->cpuset);
+        memo->locality_done = true;
+    }
+    if (NULL == memo->locality) {
+        return NULL;
+    }
+    return strdup(memo->locality);
+}
+
 char* prrte_hwloc_base_get_location(char *locality,
                                    hwloc_obj_type_t type,
                                    unsigned index)
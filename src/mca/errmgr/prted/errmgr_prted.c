@@ -476,6 +476,12 @@ static void proc_errors(int fd, short args, void *cbdata)
                          prrte_proc_state_to_str(state),
                          PRRTE_NAME_PRINT(proc)));
 
+    /* if the IOF has been holding back this proc's output,
+     * let the user see how it ended */
+    if (PRRTE_PROC_STATE_KILLED_BY_CMD != state && NULL != prrte_iof.tail) {
+        prrte_iof.tail(proc, NULL);
+    }
+
     if (PRRTE_PROC_STATE_TERM_NON_ZERO == state) {
         /* update the state */
         child->state = state;
@@ -581,6 +581,7 @@ int prrte_ess_base_prted_finalize(void)
     prrte_session_dir_cleanup(PRRTE_JOBID_WILDCARD);
     /* release the job hash table */
     PRRTE_RELEASE(prrte_job_data);
+    prrte_node_lookup_invalidate();
     return PRRTE_SUCCESS;
 }
 
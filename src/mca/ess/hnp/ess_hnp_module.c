@@ -758,6 +758,7 @@ static int rte_finalize(void)
     }
 }
     PRRTE_RELEASE(prrte_node_pool);
+    prrte_node_lookup_invalidate();
 
     free(prrte_topo_signature);
 
@@ -16,11 +16,15 @@
 
 #include "prrte_config.h"
 
+#include <time.h>
+#include <sys/time.h>
+
 #include "src/mca/mca.h"
 #include "src/class/prrte_object.h"
 #include "src/event/event-internal.h"
 
 #include "src/mca/filem/filem.h"
+#include "src/mca/grpcomm/grpcomm.h"
 
 BEGIN_C_DECLS
 
@@ -28,8 +32,25 @@ PRRTE_MODULE_EXPORT extern prrte_filem_base_component_t prrte_filem_raw_componen
 PRRTE_EXPORT extern prrte_filem_base_module_t prrte_filem_raw_module;
 
 extern bool prrte_filem_raw_flatten_trees;
+extern int prrte_filem_raw_chunk_size;
+extern int prrte_filem_raw_window;
+extern int prrte_filem_raw_cache_size;
+extern bool prrte_filem_raw_compress;
+extern int prrte_filem_raw_compress_level;
+extern int prrte_filem_raw_bandwidth;
+
+#define PRRTE_FILEM_RAW_CHUNK_DEFAULT   (1024 * 1024)
+#define PRRTE_FILEM_RAW_WINDOW_DEFAULT  4
 
-#define PRRTE_FILEM_RAW_CHUNK_MAX 16384
+/* chunk number of the message announcing the content of a
+ * file before any of it is sent */
+#define PRRTE_FILEM_RAW_ANNOUNCE   -2
+/* ack status from a daemon that does not have the announced
+ * content in its cache and needs it sent */
+#define PRRTE_FILEM_RAW_NEED        1
+/* number of chunks to send uncompressed before trying again
+ * to compress content that didn't compress */
+#define PRRTE_FILEM_RAW_PROBE      16
 
 /* local classes */
 typedef struct {
@@ -47,6 +68,24 @@ typedef struct {
     prrte_app_idx_t app_idx;
     prrte_event_t ev;
     bool pending;
+    int32_t id;             /* numeric id carried by every chunk */
+    int fd;
+    unsigned char *map;     /* mmap of the source, if we could map it */
+    unsigned char *buf;     /* pread buffer used when the map failed */
+    size_t size;
+    time_t mtime;
+    size_t offset;
+    prrte_grpcomm_signature_t *sig;
+    char *key;              /* content key announced to the daemons */
+    bool announced;
+    bool direct;            /* send only to the daemons that need it */
+    prrte_vpid_t *need;
+    prrte_vpid_t nneed;
+    int level;              /* current compression level, 0 if off */
+    int probe;
+    size_t wirebytes;       /* bytes we put on the wire */
+    double cmpusec;         /* time spent compressing them */
+    struct timeval start;
     char *src;
     char *file;
     int32_t type;
@@ -61,7 +100,10 @@ typedef struct {
     prrte_app_idx_t app_idx;
     prrte_event_t ev;
     bool pending;
+    int32_t id;
     int fd;
+    char *key;
+    bool cached;
     char *file;
     char *top;
     char *fullpath;
@@ -74,10 +116,19 @@ PRRTE_CLASS_DECLARATION(prrte_filem_raw_incoming_t);
 typedef struct {
     prrte_list_item_t super;
     int numbytes;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
+    unsigned char *data;
 } prrte_filem_raw_output_t;
 PRRTE_CLASS_DECLARATION(prrte_filem_raw_output_t);
 
+typedef struct {
+    prrte_list_item_t super;
+    char *key;
+    char *path;
+    size_t size;
+    time_t mtime;
+} prrte_filem_raw_cache_t;
+PRRTE_CLASS_DECLARATION(prrte_filem_raw_cache_t);
+
 END_C_DECLS
 
 #endif /* PRRtE_FILEM_RAW_EXPORT_H */
@@ -37,6 +37,12 @@ static int filem_raw_close(void);
 static int filem_raw_query(prrte_mca_base_module_t **module, int *priority);
 
 bool prrte_filem_raw_flatten_trees=false;
+int prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_DEFAULT;
+int prrte_filem_raw_window = PRRTE_FILEM_RAW_WINDOW_DEFAULT;
+int prrte_filem_raw_cache_size = 1024;
+bool prrte_filem_raw_compress = false;
+int prrte_filem_raw_compress_level = 0;
+int prrte_filem_raw_bandwidth = 1000;
 
 prrte_filem_base_component_t prrte_filem_raw_component = {
     .base_version = {
@@ -70,6 +76,71 @@ static int filem_raw_register(void)
                                            PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                            &prrte_filem_raw_flatten_trees);
 
+    prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_DEFAULT;
+    (void) prrte_mca_base_component_var_register(c, "chunk_size",
+                                           "Number of bytes of a file to send in each message when prepositioning it (default: 1MB)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_chunk_size);
+    if (prrte_filem_raw_chunk_size <= 0) {
+        prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_DEFAULT;
+    }
+
+    prrte_filem_raw_window = PRRTE_FILEM_RAW_WINDOW_DEFAULT;
+    (void) prrte_mca_base_component_var_register(c, "window",
+                                           "Number of chunks of a file to send each time the transfer is serviced, with the reads for the next window prefetched while they go out (default: 4)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_window);
+    if (prrte_filem_raw_window <= 0) {
+        prrte_filem_raw_window = 1;
+    }
+
+    prrte_filem_raw_cache_size = 1024;
+    (void) prrte_mca_base_component_var_register(c, "cache_size",
+                                           "Maximum number of megabytes of prepositioned files each daemon keeps in its content cache so they need not be sent again (0 disables the cache)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_cache_size);
+    if (prrte_filem_raw_cache_size < 0) {
+        prrte_filem_raw_cache_size = 0;
+    }
+
+    prrte_filem_raw_compress = false;
+    (void) prrte_mca_base_component_var_register(c, "compress",
+                                           "Compress each chunk of a file as it is prepositioned",
+                                           PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_compress);
+
+    prrte_filem_raw_compress_level = 0;
+    (void) prrte_mca_base_component_var_register(c, "compress_level",
+                                           "Level at which to compress prepositioned files, from 1 (fastest) to 9 (smallest) - 0 chooses the level from the measured compression and network rates",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_compress_level);
+    if (prrte_filem_raw_compress_level < 0) {
+        prrte_filem_raw_compress_level = 0;
+    } else if (9 < prrte_filem_raw_compress_level) {
+        prrte_filem_raw_compress_level = 9;
+    }
+
+    prrte_filem_raw_bandwidth = 1000;
+    (void) prrte_mca_base_component_var_register(c, "bandwidth",
+                                           "Network rate in MB/s to assume when choosing a compression level until one has been measured",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_bandwidth);
+    if (prrte_filem_raw_bandwidth <= 0) {
+        prrte_filem_raw_bandwidth = 1000;
+    }
+
     return PRRTE_SUCCESS;
 }
 
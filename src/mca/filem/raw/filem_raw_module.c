@@ -32,6 +32,9 @@
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 
 #include "src/class/prrte_list.h"
 #include "src/event/event-internal.h"
@@ -45,6 +48,7 @@
 #include "src/util/os_path.h"
 #include "src/util/path.h"
 #include "src/util/basename.h"
+#include "src/util/crc.h"
 
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
@@ -54,6 +58,7 @@
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/grpcomm/base/base.h"
 #include "src/mca/rml/rml.h"
+#include "src/mca/prtecompress/prtecompress.h"
 
 #include "src/mca/filem/filem.h"
 #include "src/mca/filem/base/base.h"
@@ -88,8 +93,17 @@ prrte_filem_base_module_t prrte_filem_raw_module = {
 static prrte_list_t outbound_files;
 static prrte_list_t incoming_files;
 static prrte_list_t positioned_files;
+static int32_t next_xfer_id = 0;
+static prrte_list_t cache_entries;
+static size_t cache_bytes = 0;
+/* delivered rate of past transfers in bytes/usec (i.e., MB/s) */
+static double net_rate = 0.0;
+/* a window is resent only after the next pass of the event loop */
+static const struct timeval rearm_delay = {0, 0};
 
 static void send_chunk(int fd, short argc, void *cbdata);
+static void prefetch(prrte_filem_raw_xfer_t *rev);
+static void xfer_close(prrte_filem_raw_xfer_t *rev);
 static void recv_files(int status, prrte_process_name_t* sender,
                        prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                        void* cbdata);
@@ -97,6 +111,7 @@ static void recv_ack(int status, prrte_process_name_t* sender,
                      prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                      void* cbdata);
 static void write_handler(int fd, short event, void *cbdata);
+static void finish_incoming(prrte_filem_raw_incoming_t *sink);
 
 static char *filem_session_dir(void)
 {
@@ -109,9 +124,104 @@ static char *filem_session_dir(void)
     return session_dir;
 }
 
+/* the content cache lives beside the positioned files so
+ * that hits can be hard-linked into place */
+static char *cache_path(char *key)
+{
+    return prrte_os_path(false, filem_session_dir(), "filem-cache", key, NULL);
+}
+
+static prrte_filem_raw_cache_t* cache_lookup(char *key)
+{
+    prrte_filem_raw_cache_t *cache;
+    struct stat buf;
+
+    PRRTE_LIST_FOREACH(cache, &cache_entries, prrte_filem_raw_cache_t) {
+        if (0 != strcmp(key, cache->key)) {
+            continue;
+        }
+        /* the entry shares its inode with the copies we linked
+         * into place - if one of those was modified, then the
+         * entry no longer holds this content */
+        if (0 != stat(cache->path, &buf) ||
+            (size_t)buf.st_size != cache->size ||
+            buf.st_mtime != cache->mtime) {
+            PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw: dropping stale cache entry %s",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), cache->key));
+            prrte_list_remove_item(&cache_entries, &cache->super);
+            cache_bytes -= cache->size;
+            unlink(cache->path);
+            PRRTE_RELEASE(cache);
+            return NULL;
+        }
+        /* keep the list in least-recently-used order */
+        prrte_list_remove_item(&cache_entries, &cache->super);
+        prrte_list_append(&cache_entries, &cache->super);
+        return cache;
+    }
+    return NULL;
+}
+
+static void cache_insert(prrte_filem_raw_incoming_t *sink)
+{
+    size_t limit = (size_t)prrte_filem_raw_cache_size * 1024 * 1024;
+    prrte_filem_raw_cache_t *cache;
+    prrte_list_item_t *item;
+    struct stat buf;
+    char *path, *dir;
+
+    if (NULL == sink->key || 0 == limit ||
+        NULL != cache_lookup(sink->key)) {
+        return;
+    }
+    if (0 != stat(sink->fullpath, &buf) || limit < (size_t)buf.st_size) {
+        return;
+    }
+    path = cache_path(sink->key);
+    dir = prrte_dirname(path);
+    if (PRRTE_SUCCESS != prrte_os_dirpath_create(dir, S_IRWXU)) {
+        free(dir);
+        free(path);
+        return;
+    }
+    free(dir);
+    unlink(path);
+    if (0 != link(sink->fullpath, path)) {
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw: unable to cache file %s: %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             sink->file, strerror(errno)));
+        free(path);
+        return;
+    }
+    /* make room, oldest first */
+    while (limit < cache_bytes + (size_t)buf.st_size &&
+           NULL != (item = prrte_list_remove_first(&cache_entries))) {
+        cache = (prrte_filem_raw_cache_t*)item;
+        cache_bytes -= cache->size;
+        unlink(cache->path);
+        PRRTE_RELEASE(cache);
+    }
+    cache = PRRTE_NEW(prrte_filem_raw_cache_t);
+    cache->key = strdup(sink->key);
+    cache->path = path;
+    cache->size = buf.st_size;
+    cache->mtime = buf.st_mtime;
+    prrte_list_append(&cache_entries, &cache->super);
+    cache_bytes += cache->size;
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: cached file %s as %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         sink->file, sink->key));
+}
+
 static int raw_init(void)
 {
     PRRTE_CONSTRUCT(&incoming_files, prrte_list_t);
+    PRRTE_CONSTRUCT(&cache_entries, prrte_list_t);
+    cache_bytes = 0;
+    net_rate = prrte_filem_raw_bandwidth;
 
     /* start a recv to catch any files sent to me */
     prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD,
@@ -142,6 +252,8 @@ static int raw_finalize(void)
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&incoming_files);
+    /* the cached files themselves go away with the session dir */
+    PRRTE_LIST_DESTRUCT(&cache_entries);
 
     if (PRRTE_PROC_IS_MASTER) {
         while (NULL != (item = prrte_list_remove_first(&outbound_files))) {
@@ -160,12 +272,31 @@ static int raw_finalize(void)
 static void xfer_complete(int status, prrte_filem_raw_xfer_t *xfer)
 {
     prrte_filem_raw_outbound_t *outbound = xfer->outbound;
+    struct timeval now;
+    double usec;
+
+    /* track how fast files actually get delivered so we
+     * can pick the compression level for later chunks - the
+     * clock started once the announcement was answered, and
+     * the time we spent compressing isn't the network's */
+    if (0 < xfer->wirebytes) {
+        gettimeofday(&now, NULL);
+        usec = (now.tv_sec - xfer->start.tv_sec) * 1000000.0 +
+               (now.tv_usec - xfer->start.tv_usec) - xfer->cmpusec;
+        if (0 < usec) {
+            net_rate = (net_rate + xfer->wirebytes / usec) / 2.0;
+        }
+    }
 
     /* transfer the status, if not success */
     if (PRRTE_SUCCESS != status) {
         outbound->status = status;
     }
 
+    /* nothing more will be read from the source - a file every
+     * daemon already held was never sent, so it is still open */
+    xfer_close(xfer);
+
     /* this transfer is complete - remove it from list */
     prrte_list_remove_item(&outbound->xfers, &xfer->super);
     /* add it to the list of files that have been positioned */
@@ -183,6 +314,79 @@ static void xfer_complete(int status, prrte_filem_raw_xfer_t *xfer)
     }
 }
 
+static void start_xfer(prrte_filem_raw_xfer_t *xfer)
+{
+    xfer->announced = false;
+    gettimeofday(&xfer->start, NULL);
+    xfer->pending = true;
+    PRRTE_POST_OBJECT(xfer);
+    prrte_event_evtimer_add(&xfer->ev, &rearm_delay);
+}
+
+/* identify the content of a file by its size and a pair
+ * of checksums over it */
+static char *content_key(prrte_filem_raw_xfer_t *xfer)
+{
+    unsigned int crc = CRC_INITIAL_REGISTER, sum = 0, lastint = 0;
+    size_t lastlen = 0, off, len;
+    ssize_t nread;
+    unsigned char *data;
+    char *key;
+
+    for (off=0; off < xfer->size; off += len) {
+        len = xfer->size - off;
+        if ((size_t)prrte_filem_raw_chunk_size < len) {
+            len = prrte_filem_raw_chunk_size;
+        }
+        if (NULL != xfer->map) {
+            data = xfer->map + off;
+        } else {
+            nread = pread(xfer->fd, xfer->buf, len, off);
+            if (nread < 0 && EINTR == errno) {
+                len = 0;
+                continue;
+            }
+            if (nread <= 0) {
+                return NULL;
+            }
+            len = nread;
+            data = xfer->buf;
+        }
+        crc = prrte_uicrc_partial(data, len, crc);
+        sum += prrte_uicsum_partial(data, len, &lastint, &lastlen);
+    }
+    prrte_asprintf(&key, "%lx-%08x-%08x", (unsigned long)xfer->size, crc, sum);
+    return key;
+}
+
+/* tell the daemons what content is coming so those that
+ * already hold it in their cache can say so */
+static int announce(prrte_filem_raw_xfer_t *xfer)
+{
+    prrte_buffer_t buf;
+    int32_t nchunk = PRRTE_FILEM_RAW_ANNOUNCE;
+    int rc;
+
+    PRRTE_CONSTRUCT(&buf, prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &xfer->id, 1, PRRTE_INT32)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &nchunk, 1, PRRTE_INT32)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &xfer->file, 1, PRRTE_STRING)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &xfer->type, 1, PRRTE_INT32)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &xfer->key, 1, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_DESTRUCT(&buf);
+        return rc;
+    }
+    xfer->nneed = 0;
+    xfer->announced = true;
+    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.xcast(xfer->sig, PRRTE_RML_TAG_FILEM_BASE, &buf))) {
+        PRRTE_ERROR_LOG(rc);
+        xfer->announced = false;
+    }
+    PRRTE_DESTRUCT(&buf);
+    return rc;
+}
+
 static void recv_ack(int status, prrte_process_name_t* sender,
                      prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                      void* cbdata)
@@ -222,12 +426,17 @@ static void recv_ack(int status, prrte_process_name_t* sender,
              itm = prrte_list_get_next(itm)) {
             xfer = (prrte_filem_raw_xfer_t*)itm;
             if (0 == strcmp(file, xfer->file)) {
-                /* if the status isn't success, record it */
-                if (0 != st) {
-                    xfer->status = st;
+                if (PRRTE_FILEM_RAW_NEED == st) {
+                    /* this daemon doesn't have the content cached */
+                    xfer->need[xfer->nneed++] = sender->vpid;
+                } else {
+                    /* if the status isn't success, record it */
+                    if (0 != st) {
+                        xfer->status = st;
+                    }
+                    /* track number of respondents */
+                    xfer->nrecvd++;
                 }
-                /* track number of respondents */
-                xfer->nrecvd++;
                 /* if all daemons have responded, then this is complete */
                 if (xfer->nrecvd == prrte_process_info.num_procs) {
                     PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
@@ -235,6 +444,17 @@ static void recv_ack(int status, prrte_process_name_t* sender,
                                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                                          file, xfer->status));
                     xfer_complete(xfer->status, xfer);
+                } else if (xfer->announced &&
+                           xfer->nrecvd + xfer->nneed == prrte_process_info.num_procs) {
+                    /* everyone has answered the announcement - send it to
+                     * the daemons that need it directly if they are few,
+                     * otherwise down the tree to all */
+                    xfer->direct = (2 * xfer->nneed <= prrte_process_info.num_procs);
+                    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                         "%s filem:raw: sending file %s to %d daemons",
+                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file,
+                                         (int)xfer->nneed));
+                    start_xfer(xfer);
                 }
                 free(file);
                 return;
@@ -252,7 +472,8 @@ static int raw_preposition_files(prrte_job_t *jdata,
     prrte_filem_base_file_set_t *fs;
     int fd;
     prrte_filem_raw_xfer_t *xfer, *xptr;
-    int flags, i, j;
+    struct stat sbuf;
+    int i, j, rc;
     char **files=NULL;
     prrte_filem_raw_outbound_t *outbound, *optr;
     char *cptr, *nxt, *filestring;
@@ -427,28 +648,11 @@ static int raw_preposition_files(prrte_job_t *jdata,
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                              fs->local_target));
 
-        /* have we already sent this file? */
-        already_sent = false;
-        for (itm = prrte_list_get_first(&positioned_files);
-             !already_sent && itm != prrte_list_get_end(&positioned_files);
-             itm = prrte_list_get_next(itm)) {
-            xptr = (prrte_filem_raw_xfer_t*)itm;
-            if (0 == strcmp(fs->local_target, xptr->src)) {
-                already_sent = true;
-            }
-        }
-        if (already_sent) {
-            /* no need to send it again */
-            PRRTE_OUTPUT_VERBOSE((3, prrte_filem_base_framework.framework_output,
-                                 "%s filem:raw: file %s is already in position - ignoring",
-                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
-            PRRTE_RELEASE(item);
-            continue;
-        }
-        /* also have to check if this file is already in the process
+        /* have to check if this file is already in the process
          * of being transferred, or was included multiple times
          * for transfer
          */
+        already_sent = false;
         for (itm = prrte_list_get_first(&outbound_files);
              !already_sent && itm != prrte_list_get_end(&outbound_files);
              itm = prrte_list_get_next(itm)) {
@@ -472,25 +676,18 @@ static int raw_preposition_files(prrte_job_t *jdata,
         }
 
         /* attempt to open the specified file */
-        if (0 > (fd = open(fs->local_target, O_RDONLY))) {
+        if (0 > (fd = open(fs->local_target, O_RDONLY)) ||
+            0 != fstat(fd, &sbuf)) {
             prrte_output(0, "%s CANNOT ACCESS FILE %s",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target);
+            if (0 <= fd) {
+                close(fd);
+            }
             PRRTE_RELEASE(item);
             prrte_list_remove_item(&outbound_files, &outbound->super);
             PRRTE_RELEASE(outbound);
             return PRRTE_ERROR;
         }
-        /* set the flags to non-blocking */
-        if ((flags = fcntl(fd, F_GETFL, 0)) < 0) {
-            prrte_output(prrte_filem_base_framework.framework_output, "[%s:%d]: fcntl(F_GETFL) failed with errno=%d\n",
-                        __FILE__, __LINE__, errno);
-        } else {
-            flags |= O_NONBLOCK;
-            if (fcntl(fd, F_SETFL, flags) < 0) {
-                prrte_output(prrte_filem_base_framework.framework_output, "[%s:%d]: fcntl(F_GETFL) failed with errno=%d\n",
-                            __FILE__, __LINE__, errno);
-            }
-        }
         PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                              "%s filem:raw: setting up to position file %s",
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
@@ -536,12 +733,100 @@ static int raw_preposition_files(prrte_job_t *jdata,
         xfer->type = fs->target_flag;
         xfer->app_idx = fs->app_idx;
         xfer->outbound = outbound;
+        xfer->id = next_xfer_id++;
+        xfer->fd = fd;
+        xfer->size = sbuf.st_size;
+        xfer->mtime = sbuf.st_mtime;
+#ifdef HAVE_SYS_MMAN_H
+        /* map the file so each chunk can be packed straight from
+         * the page cache, and ask the kernel to start reading ahead
+         * on the first window */
+        if (0 < xfer->size) {
+            xfer->map = (unsigned char*)mmap(NULL, xfer->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED == xfer->map) {
+                xfer->map = NULL;
+            } else {
+                (void)madvise(xfer->map, xfer->size, MADV_SEQUENTIAL);
+                prefetch(xfer);
+            }
+        }
+#endif
+        if (NULL == xfer->map) {
+            /* fall back to reading each chunk with pread */
+            xfer->buf = (unsigned char*)malloc(prrte_filem_raw_chunk_size);
+            if (NULL == xfer->buf) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                PRRTE_RELEASE(xfer);
+                PRRTE_RELEASE(item);
+                prrte_list_remove_item(&outbound_files, &outbound->super);
+                PRRTE_RELEASE(outbound);
+                return PRRTE_ERR_OUT_OF_RESOURCE;
+            }
+        }
+        /* identify the content so the daemons can check their cache -
+         * reading the whole file is costly, so reuse the key of an
+         * earlier transfer of it if it hasn't changed since */
+        if (0 < prrte_filem_raw_cache_size) {
+            for (itm = prrte_list_get_first(&positioned_files);
+                 itm != prrte_list_get_end(&positioned_files);
+                 itm = prrte_list_get_next(itm)) {
+                xptr = (prrte_filem_raw_xfer_t*)itm;
+                if (NULL != xptr->key && xptr->size == xfer->size &&
+                    xptr->mtime == xfer->mtime && 0 == strcmp(xfer->src, xptr->src)) {
+                    xfer->key = strdup(xptr->key);
+                    break;
+                }
+            }
+            if (NULL == xfer->key) {
+                xfer->key = content_key(xfer);
+            }
+        }
+        /* have we already sent this file? */
+        for (itm = prrte_list_get_first(&positioned_files);
+             !already_sent && itm != prrte_list_get_end(&positioned_files);
+             itm = prrte_list_get_next(itm)) {
+            xptr = (prrte_filem_raw_xfer_t*)itm;
+            if (0 == strcmp(fs->local_target, xptr->src) &&
+                (NULL == xfer->key || NULL == xptr->key ||
+                 0 == strcmp(xfer->key, xptr->key))) {
+                already_sent = true;
+            }
+        }
+        if (already_sent) {
+            /* no need to send it again */
+            PRRTE_OUTPUT_VERBOSE((3, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw: file %s is already in position - ignoring",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
+            PRRTE_RELEASE(xfer);
+            PRRTE_RELEASE(item);
+            continue;
+        }
+        if (NULL != xfer->key) {
+            /* room to track the daemons that answer the announcement
+             * by asking for the content */
+            xfer->need = (prrte_vpid_t*)malloc(prrte_process_info.num_procs * sizeof(prrte_vpid_t));
+            if (NULL == xfer->need) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                outbound->status = PRRTE_ERR_OUT_OF_RESOURCE;
+                PRRTE_RELEASE(xfer);
+                PRRTE_RELEASE(item);
+                continue;
+            }
+        }
+        /* all chunks of this file go to all daemons */
+        xfer->sig = PRRTE_NEW(prrte_grpcomm_signature_t);
+        xfer->sig->signature = (prrte_process_name_t*)malloc(sizeof(prrte_process_name_t));
+        xfer->sig->signature[0].jobid = PRRTE_PROC_MY_NAME->jobid;
+        xfer->sig->signature[0].vpid = PRRTE_VPID_WILDCARD;
+        xfer->sig->sz = 1;
         prrte_list_append(&outbound->xfers, &xfer->super);
-        prrte_event_set(prrte_event_base, &xfer->ev, fd, PRRTE_EV_READ, send_chunk, xfer);
+        prrte_event_evtimer_set(prrte_event_base, &xfer->ev, send_chunk, xfer);
         prrte_event_set_priority(&xfer->ev, PRRTE_MSG_PRI);
-        xfer->pending = true;
-        PRRTE_POST_OBJECT(xfer);
-        prrte_event_add(&xfer->ev, 0);
+        /* if we know the content, ask who already has it - we start
+         * sending once they have all answered */
+        if (NULL == xfer->key || PRRTE_SUCCESS != announce(xfer)) {
+            start_xfer(xfer);
+        }
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&fsets);
@@ -553,10 +838,11 @@ static int raw_preposition_files(prrte_job_t *jdata,
         PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                              "%s filem:raw: all duplicate files - no positioning reqd",
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
+        rc = outbound->status;
         prrte_list_remove_item(&outbound_files, &outbound->super);
         PRRTE_RELEASE(outbound);
         if (NULL != cbfunc) {
-            cbfunc(PRRTE_SUCCESS, cbdata);
+            cbfunc(rc, cbdata);
         }
         return PRRTE_SUCCESS;
     }
@@ -749,109 +1035,288 @@ static int raw_link_local_files(prrte_job_t *jdata,
     return PRRTE_SUCCESS;
 }
 
-static void send_chunk(int fd, short argc, void *cbdata)
+/* drop the source once the last chunk of a file has gone out - the
+ * xfer itself is kept on the positioned list to avoid resending it */
+static void xfer_close(prrte_filem_raw_xfer_t *rev)
 {
-    prrte_filem_raw_xfer_t *rev = (prrte_filem_raw_xfer_t*)cbdata;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
-    int32_t numbytes;
-    int rc;
-    prrte_buffer_t chunk;
-    prrte_grpcomm_signature_t *sig;
+#ifdef HAVE_SYS_MMAN_H
+    if (NULL != rev->map) {
+        munmap(rev->map, rev->size);
+        rev->map = NULL;
+    }
+#endif
+    if (NULL != rev->buf) {
+        free(rev->buf);
+        rev->buf = NULL;
+    }
+    if (0 <= rev->fd) {
+        close(rev->fd);
+        rev->fd = -1;
+    }
+}
 
-    PRRTE_ACQUIRE_OBJECT(rev);
+/* ask the kernel to start reading the next window of chunks
+ * so the disk is busy while the current window is on the wire */
+static void prefetch(prrte_filem_raw_xfer_t *rev)
+{
+#ifdef HAVE_SYS_MMAN_H
+    size_t start, len;
+    long pgsz;
 
-    /* flag that event has fired */
-    rev->pending = false;
+    if (NULL == rev->map || rev->size <= rev->offset) {
+        return;
+    }
+    /* madvise requires a page-aligned start */
+    pgsz = sysconf(_SC_PAGESIZE);
+    start = rev->offset - (rev->offset % (size_t)pgsz);
+    len = (size_t)prrte_filem_raw_chunk_size * prrte_filem_raw_window;
+    if (rev->size - start < len) {
+        len = rev->size - start;
+    }
+    (void)madvise(rev->map + start, len, MADV_WILLNEED);
+#endif
+}
 
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
+/* compress a chunk at the current level of its transfer. Unless
+ * the level was fixed, lower it when compression can't keep up
+ * with the network and raise it when it has time to spare */
+static void compress_chunk(prrte_filem_raw_xfer_t *rev,
+                           unsigned char *data, int32_t numbytes,
+                           uint8_t **cmpdata, int32_t *cmplen)
+{
+    struct timeval start, end;
+    size_t olen;
+    double usec, cpu, ratio, rate;
 
-    if (numbytes < 0) {
-        /* either we have a connection error or it was a non-blocking read */
+    *cmpdata = NULL;
+    *cmplen = 0;
 
-        /* non-blocking, retry */
-        if (EAGAIN == errno || EINTR == errno) {
-            PRRTE_POST_OBJECT(rev);
-            prrte_event_add(&rev->ev, 0);
+    if (0 == rev->level) {
+        /* this content hasn't been compressing - try again
+         * every so often in case that changes */
+        if (0 < --rev->probe) {
             return;
         }
+        rev->level = 1;
+    }
 
-        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                             "%s filem:raw:read error on file %s",
-                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), rev->file));
+    gettimeofday(&start, NULL);
+    if (!prrte_compress.compress_block_level(data, numbytes, rev->level, cmpdata, &olen)) {
+        /* no compression available */
+        rev->level = 0;
+        rev->probe = INT32_MAX;
+        return;
+    }
+    gettimeofday(&end, NULL);
+    usec = (end.tv_sec - start.tv_sec) * 1000000.0 + (end.tv_usec - start.tv_usec);
+    rev->cmpusec += usec;
+    if ((size_t)numbytes <= olen) {
+        free(*cmpdata);
+        *cmpdata = NULL;
+    } else {
+        *cmplen = olen;
+    }
+    if (0 < prrte_filem_raw_compress_level) {
+        return;
+    }
 
-        /* Un-recoverable error. Allow the code to flow as usual in order to
-         * to send the zero bytes message up the stream, and then close the
-         * file descriptor and delete the event.
-         */
-        numbytes = 0;
+    ratio = (double)olen / (double)numbytes;
+    if (0.9 < ratio) {
+        rev->level = 0;
+        rev->probe = PRRTE_FILEM_RAW_PROBE;
+        return;
+    }
+    cpu = numbytes / (usec < 1.0 ? 1.0 : usec);
+    /* the network needs ratio/rate usec per input byte, where
+     * sending direct puts a copy on the wire for each daemon */
+    rate = net_rate;
+    if (rev->direct && 1 < rev->nneed) {
+        rate /= rev->nneed;
     }
+    if (cpu < rate / ratio) {
+        if (1 < rev->level) {
+            rev->level--;
+        }
+    } else if (2.0 * rate / ratio < cpu) {
+        if (rev->level < 9) {
+            rev->level++;
+        }
+    }
+}
+
+static void send_chunk(int fd, short argc, void *cbdata)
+{
+    prrte_filem_raw_xfer_t *rev = (prrte_filem_raw_xfer_t*)cbdata;
+    unsigned char *data;
+    uint8_t *cmpdata;
+    int32_t numbytes, cmplen;
+    size_t len;
+    int rc, n;
+    prrte_vpid_t i;
+    prrte_buffer_t chunk, *buf;
+    prrte_process_name_t target;
+
+    PRRTE_ACQUIRE_OBJECT(rev);
+
+    /* flag that event has fired */
+    rev->pending = false;
 
     /* if job termination has been ordered, just ignore the
      * data and delete the read event
      */
     if (prrte_job_term_ordered) {
+        xfer_close(rev);
         PRRTE_RELEASE(rev);
         return;
     }
 
-    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                         "%s filem:raw:read handler sending chunk %d of %d bytes for file %s",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                         rev->nchunk, numbytes, rev->file));
+    /* send a window of chunks before letting the event
+     * library service anything else */
+    for (n=0; n < prrte_filem_raw_window; n++) {
+        /* take up to the chunk size */
+        if ((size_t)prrte_filem_raw_chunk_size < rev->size - rev->offset) {
+            numbytes = prrte_filem_raw_chunk_size;
+        } else {
+            numbytes = rev->size - rev->offset;
+        }
+        if (NULL != rev->map) {
+            data = rev->map + rev->offset;
+        } else {
+            data = rev->buf;
+            if (0 < numbytes) {
+                numbytes = pread(rev->fd, data, numbytes, rev->offset);
+                if (numbytes < 0) {
+                    if (EINTR == errno) {
+                        n--;
+                        continue;
+                    }
+                    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                         "%s filem:raw:read error on file %s",
+                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), rev->file));
+                    /* Un-recoverable error. Allow the code to flow as usual in order to
+                     * to send the zero bytes message up the stream, and then close the
+                     * file descriptor and delete the event.
+                     */
+                    numbytes = 0;
+                }
+            }
+        }
 
-    /* package it for transmission */
-    PRRTE_CONSTRUCT(&chunk, prrte_buffer_t);
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->file, 1, PRRTE_STRING))) {
-        PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
-    }
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->nchunk, 1, PRRTE_INT32))) {
-        PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
-    }
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, data, numbytes, PRRTE_BYTE))) {
-        PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
-    }
-    /* if it is the first chunk, then add file type and index of the app */
-    if (0 == rev->nchunk) {
-        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->type, 1, PRRTE_INT32))) {
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw:read handler sending chunk %d of %d bytes for file %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             rev->nchunk, numbytes, rev->file));
+
+        /* package it for transmission - the receivers learn the name
+         * and type of the file from the first chunk, and only need the
+         * numeric id thereafter */
+        PRRTE_CONSTRUCT(&chunk, prrte_buffer_t);
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->id, 1, PRRTE_INT32))) {
             PRRTE_ERROR_LOG(rc);
-            close(fd);
+            PRRTE_DESTRUCT(&chunk);
+            xfer_close(rev);
+            return;
+        }
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->nchunk, 1, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            xfer_close(rev);
+            return;
+        }
+        if (0 == rev->nchunk) {
+            if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->file, 1, PRRTE_STRING))) {
+                PRRTE_ERROR_LOG(rc);
+                PRRTE_DESTRUCT(&chunk);
+                xfer_close(rev);
+                return;
+            }
+            if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->type, 1, PRRTE_INT32))) {
+                PRRTE_ERROR_LOG(rc);
+                PRRTE_DESTRUCT(&chunk);
+                xfer_close(rev);
+                return;
+            }
+        }
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &numbytes, 1, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            xfer_close(rev);
+            return;
+        }
+        cmpdata = NULL;
+        cmplen = 0;
+        if (prrte_filem_raw_compress && 0 < numbytes) {
+            compress_chunk(rev, data, numbytes, &cmpdata, &cmplen);
+        }
+        /* a zero compressed length means the data follows as-is */
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &cmplen, 1, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            if (NULL != cmpdata) {
+                free(cmpdata);
+            }
+            xfer_close(rev);
+            return;
+        }
+        if (0 < cmplen) {
+            rc = prrte_dss.pack(&chunk, cmpdata, cmplen, PRRTE_BYTE);
+            free(cmpdata);
+            len = cmplen;
+        } else if (0 < numbytes) {
+            rc = prrte_dss.pack(&chunk, data, numbytes, PRRTE_BYTE);
+            len = numbytes;
+        } else {
+            len = 0;
+        }
+        /* sending direct puts a copy on the wire for each daemon */
+        rev->wirebytes += (rev->direct) ? len * rev->nneed : len;
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            xfer_close(rev);
             return;
         }
-    }
 
-    /* goes to all daemons */
-    sig = PRRTE_NEW(prrte_grpcomm_signature_t);
-    sig->signature = (prrte_process_name_t*)malloc(sizeof(prrte_process_name_t));
-    sig->signature[0].jobid = PRRTE_PROC_MY_NAME->jobid;
-    sig->signature[0].vpid = PRRTE_VPID_WILDCARD;
-    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.xcast(sig, PRRTE_RML_TAG_FILEM_BASE, &chunk))) {
-        PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
+        if (rev->direct) {
+            /* only a few daemons lack this content */
+            for (i=0; i < rev->nneed; i++) {
+                target.jobid = PRRTE_PROC_MY_NAME->jobid;
+                target.vpid = rev->need[i];
+                buf = PRRTE_NEW(prrte_buffer_t);
+                prrte_dss.copy_payload(buf, &chunk);
+                if (0 > (rc = prrte_rml.send_buffer_nb(&target, buf,
+                                                      PRRTE_RML_TAG_FILEM_BASE,
+                                                      prrte_rml_send_callback, NULL))) {
+                    PRRTE_ERROR_LOG(rc);
+                    PRRTE_RELEASE(buf);
+                }
+            }
+        } else if (PRRTE_SUCCESS != (rc = prrte_grpcomm.xcast(rev->sig, PRRTE_RML_TAG_FILEM_BASE, &chunk))) {
+            /* goes to all daemons */
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            xfer_close(rev);
+            return;
+        }
+        PRRTE_DESTRUCT(&chunk);
+        rev->nchunk++;
+        rev->offset += numbytes;
+
+        /* if num_bytes was zero, then we are done with
+         * this file */
+        if (0 == numbytes) {
+            xfer_close(rev);
+            return;
+        }
     }
-    PRRTE_DESTRUCT(&chunk);
-    PRRTE_RELEASE(sig);
-    rev->nchunk++;
 
-    /* if num_bytes was zero, then we need to terminate the event
-     * and close the file descriptor
-     */
-    if (0 == numbytes) {
-        close(fd);
-        return;
-    } else {
-        /* restart the read event */
-        rev->pending = true;
-        PRRTE_POST_OBJECT(rev);
-        prrte_event_add(&rev->ev, 0);
-    }
+    /* start the disk on the next window and come back for it once
+     * the event loop has polled the sockets, so the chunks just
+     * queued drain before we pack more */
+    prefetch(rev);
+    rev->pending = true;
+    PRRTE_POST_OBJECT(rev);
+    prrte_event_evtimer_add(&rev->ev, &rearm_delay);
 }
 
 static void send_complete(char *file, int status)
@@ -942,23 +1407,96 @@ static int link_archive(prrte_filem_raw_incoming_t *inbnd)
     return PRRTE_SUCCESS;
 }
 
+/* setup the location of an incoming file in our session dir */
+static int prep_target(prrte_filem_raw_incoming_t *incoming)
+{
+    char *tmp, *cptr;
+    int rc;
+
+    /* separate out the top-level directory of the target */
+    if (NULL != incoming->top) {
+        free(incoming->top);
+    }
+    tmp = strdup(incoming->file);
+    if (NULL != (cptr = strchr(tmp, '/'))) {
+        *cptr = '\0';
+    }
+    incoming->top = tmp;
+    /* define the full path to where we will put it */
+    if (NULL != incoming->fullpath) {
+        free(incoming->fullpath);
+    }
+    incoming->fullpath = prrte_os_path(false, filem_session_dir(), incoming->file, NULL);
+    /* create the path to the target, if not already existing */
+    tmp = prrte_dirname(incoming->fullpath);
+    rc = prrte_os_dirpath_create(tmp, S_IRWXU);
+    free(tmp);
+    return rc;
+}
+
+/* the HNP is about to send us a file - if we already hold
+ * its content, link it into place and tell the HNP we are
+ * done, otherwise tell it we need the file */
+static void recv_announce(int32_t id, char *file, int32_t type, char *key)
+{
+    prrte_filem_raw_incoming_t *ptr, *incoming = NULL;
+    prrte_filem_raw_cache_t *cache;
+
+    PRRTE_LIST_FOREACH(ptr, &incoming_files, prrte_filem_raw_incoming_t) {
+        if (0 == strcmp(file, ptr->file)) {
+            incoming = ptr;
+            break;
+        }
+    }
+    if (NULL == incoming) {
+        incoming = PRRTE_NEW(prrte_filem_raw_incoming_t);
+        incoming->file = strdup(file);
+        prrte_list_append(&incoming_files, &incoming->super);
+    }
+    incoming->id = id;
+    incoming->type = type;
+    incoming->cached = false;
+    if (NULL != incoming->key) {
+        free(incoming->key);
+    }
+    incoming->key = strdup(key);
+
+    if (0 < prrte_filem_raw_cache_size &&
+        NULL != (cache = cache_lookup(key)) &&
+        PRRTE_SUCCESS == prep_target(incoming)) {
+        unlink(incoming->fullpath);
+        if (0 == link(cache->path, incoming->fullpath)) {
+            PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw: file %s found in cache as %s",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file, key));
+            incoming->cached = true;
+            finish_incoming(incoming);
+            return;
+        }
+    }
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: requesting file %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file));
+    send_complete(file, PRRTE_FILEM_RAW_NEED);
+}
+
 static void recv_files(int status, prrte_process_name_t* sender,
                        prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                        void* cbdata)
 {
-    char *file, *session_dir;
-    int32_t nchunk, n, nbytes;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
+    char *file = NULL, *key;
+    int32_t id, nchunk, n, nbytes, cmplen;
+    uint8_t *cmpdata;
     int rc;
     prrte_filem_raw_output_t *output;
     prrte_filem_raw_incoming_t *ptr, *incoming;
     prrte_list_item_t *item;
     int32_t type;
-    char *cptr;
 
-    /* unpack the data */
+    /* unpack the transfer id and chunk number */
     n=1;
-    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &file, &n, PRRTE_STRING))) {
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &id, &n, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
         send_complete(NULL, rc);
         return;
@@ -966,90 +1504,106 @@ static void recv_files(int status, prrte_process_name_t* sender,
     n=1;
     if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nchunk, &n, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
-        send_complete(file, rc);
-        free(file);
+        send_complete(NULL, rc);
         return;
     }
-    /* if the chunk number is < 0, then this is an EOF message */
-    if (nchunk < 0) {
-        /* just set nbytes to zero so we close the fd */
-        nbytes = 0;
-    } else {
-        nbytes=PRRTE_FILEM_RAW_CHUNK_MAX;
-        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &nbytes, PRRTE_BYTE))) {
+    /* if the chunk is 0 or this is an announcement, then
+     * the file info should be present */
+    if (0 == nchunk || PRRTE_FILEM_RAW_ANNOUNCE == nchunk) {
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &file, &n, PRRTE_STRING))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(NULL, rc);
+            return;
+        }
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &type, &n, PRRTE_INT32))) {
             PRRTE_ERROR_LOG(rc);
             send_complete(file, rc);
             free(file);
             return;
         }
     }
-    /* if the chunk is 0, then additional info should be present */
-    if (0 == nchunk) {
+    if (PRRTE_FILEM_RAW_ANNOUNCE == nchunk) {
         n=1;
-        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &type, &n, PRRTE_INT32))) {
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &key, &n, PRRTE_STRING))) {
             PRRTE_ERROR_LOG(rc);
             send_complete(file, rc);
             free(file);
             return;
         }
+        recv_announce(id, file, type, key);
+        free(file);
+        free(key);
+        return;
     }
 
-    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                         "%s filem:raw: received chunk %d for file %s containing %d bytes",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                         nchunk, file, nbytes));
-
-    /* do we already have this file on our list of incoming? */
+    /* find the file this chunk belongs to - after the first
+     * chunk, we only know it by its id */
     incoming = NULL;
     for (item = prrte_list_get_first(&incoming_files);
          item != prrte_list_get_end(&incoming_files);
          item = prrte_list_get_next(item)) {
         ptr = (prrte_filem_raw_incoming_t*)item;
-        if (0 == strcmp(file, ptr->file)) {
+        if (NULL != file) {
+            if (0 == strcmp(file, ptr->file)) {
+                incoming = ptr;
+                break;
+            }
+        } else if (id == ptr->id) {
             incoming = ptr;
             break;
         }
     }
     if (NULL == incoming) {
+        if (NULL == file) {
+            /* we never saw the start of this file */
+            PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
+            return;
+        }
         /* nope - add it */
         PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                              "%s filem:raw: adding file %s to incoming list",
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file));
         incoming = PRRTE_NEW(prrte_filem_raw_incoming_t);
         incoming->file = strdup(file);
-        incoming->type = type;
         prrte_list_append(&incoming_files, &incoming->super);
     }
+    if (incoming->cached && id == incoming->id) {
+        /* we linked this content from our cache when it was
+         * announced, so the rest of the daemons must need it */
+        if (NULL != file) {
+            free(file);
+        }
+        return;
+    }
 
     /* if this is the first chunk, we need to open the file descriptor */
     if (0 == nchunk) {
-        /* separate out the top-level directory of the target */
-        char *tmp;
-        tmp = strdup(file);
-        if (NULL != (cptr = strchr(tmp, '/'))) {
-            *cptr = '\0';
+        if (id != incoming->id) {
+            /* the content wasn't announced, so we can't cache it */
+            if (NULL != incoming->key) {
+                free(incoming->key);
+                incoming->key = NULL;
+            }
         }
-        /* save it */
-        incoming->top = strdup(tmp);
-        free(tmp);
-        /* define the full path to where we will put it */
-        session_dir = filem_session_dir();
-
-        incoming->fullpath = prrte_os_path(false, session_dir, file, NULL);
-
-        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                             "%s filem:raw: opening target file %s",
-                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), incoming->fullpath));
-        /* create the path to the target, if not already existing */
-        tmp = prrte_dirname(incoming->fullpath);
-        if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_create(tmp, S_IRWXU))) {
+        incoming->id = id;
+        incoming->type = type;
+        incoming->cached = false;
+        if (PRRTE_SUCCESS != (rc = prep_target(incoming))) {
             PRRTE_ERROR_LOG(rc);
             send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
             free(file);
-            free(tmp);
+            prrte_list_remove_item(&incoming_files, &incoming->super);
             PRRTE_RELEASE(incoming);
             return;
         }
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw: opening target file %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), incoming->fullpath));
+        /* the target may be a link into our cache from an earlier
+         * job - never write through it */
+        unlink(incoming->fullpath);
         /* open the file descriptor for writing */
         if (PRRTE_FILEM_TYPE_EXE == type) {
             if (0 > (incoming->fd = open(incoming->fullpath, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU))) {
@@ -1058,7 +1612,6 @@ static void recv_files(int status, prrte_process_name_t* sender,
                             incoming->fullpath);
                 send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
-                free(tmp);
                 return;
             }
         } else {
@@ -1068,26 +1621,86 @@ static void recv_files(int status, prrte_process_name_t* sender,
                             incoming->fullpath);
                 send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
-                free(tmp);
                 return;
             }
         }
-        free(tmp);
         prrte_event_set(prrte_event_base, &incoming->ev, incoming->fd,
                        PRRTE_EV_WRITE, write_handler, incoming);
         prrte_event_set_priority(&incoming->ev, PRRTE_MSG_PRI);
     }
     /* create an output object for this data */
     output = PRRTE_NEW(prrte_filem_raw_output_t);
-    if (0 < nbytes) {
+
+    /* if the chunk number is < 0, then this is an EOF message */
+    if (nchunk < 0) {
+        /* just set nbytes to zero so we close the fd */
+        nbytes = 0;
+    } else {
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nbytes, &n, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(incoming->file, rc);
+            PRRTE_RELEASE(output);
+            if (NULL != file) {
+                free(file);
+            }
+            return;
+        }
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &cmplen, &n, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(incoming->file, rc);
+            PRRTE_RELEASE(output);
+            if (NULL != file) {
+                free(file);
+            }
+            return;
+        }
         /* don't copy 0 bytes - we just need to pass
          * the zero bytes so the fd can be closed
          * after it writes everything out
          */
-        memcpy(output->data, data, nbytes);
+        if (0 < cmplen) {
+            /* expand it so the write handler sees the original data */
+            cmpdata = (uint8_t*)malloc(cmplen);
+            if (NULL == cmpdata ||
+                PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, cmpdata, &cmplen, PRRTE_BYTE)) ||
+                !prrte_compress.decompress_block(&output->data, nbytes, cmpdata, cmplen)) {
+                rc = (NULL == cmpdata) ? PRRTE_ERR_OUT_OF_RESOURCE : PRRTE_ERR_UNPACK_FAILURE;
+                PRRTE_ERROR_LOG(rc);
+                send_complete(incoming->file, rc);
+                PRRTE_RELEASE(output);
+                if (NULL != cmpdata) {
+                    free(cmpdata);
+                }
+                if (NULL != file) {
+                    free(file);
+                }
+                return;
+            }
+            free(cmpdata);
+        } else if (0 < nbytes) {
+            output->data = (unsigned char*)malloc(nbytes);
+            if (NULL == output->data ||
+                PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, output->data, &nbytes, PRRTE_BYTE))) {
+                rc = (NULL == output->data) ? PRRTE_ERR_OUT_OF_RESOURCE : rc;
+                PRRTE_ERROR_LOG(rc);
+                send_complete(incoming->file, rc);
+                PRRTE_RELEASE(output);
+                if (NULL != file) {
+                    free(file);
+                }
+                return;
+            }
+        }
     }
     output->numbytes = nbytes;
 
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: received chunk %d for file %s containing %d bytes",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         nchunk, incoming->file, nbytes));
+
     /* add this data to the write list for this fd */
     prrte_list_append(&incoming->outputs, &output->super);
 
@@ -1103,15 +1716,81 @@ static void recv_files(int status, prrte_process_name_t* sender,
 }
 
 
+/* the content of an incoming file is in place - setup its
+ * link points and report it to the HNP */
+static void finish_incoming(prrte_filem_raw_incoming_t *sink)
+{
+    char *dirname, *cmd;
+    char homedir[MAXPATHLEN];
+    int rc;
+
+    /* we may have positioned this file before */
+    prrte_argv_free(sink->link_pts);
+    sink->link_pts = NULL;
+
+    if (PRRTE_FILEM_TYPE_FILE == sink->type ||
+        PRRTE_FILEM_TYPE_EXE == sink->type) {
+        /* just link to the top as this will be the
+         * name we will want in each proc's session dir
+         */
+        prrte_argv_append_nosize(&sink->link_pts, sink->top);
+        send_complete(sink->file, PRRTE_SUCCESS);
+    } else {
+        /* unarchive the file */
+        if (PRRTE_FILEM_TYPE_TAR == sink->type) {
+            prrte_asprintf(&cmd, "tar xf %s", sink->file);
+        } else if (PRRTE_FILEM_TYPE_BZIP == sink->type) {
+            prrte_asprintf(&cmd, "tar xjf %s", sink->file);
+        } else if (PRRTE_FILEM_TYPE_GZIP == sink->type) {
+            prrte_asprintf(&cmd, "tar xzf %s", sink->file);
+        } else {
+            PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        if (NULL == getcwd(homedir, sizeof(homedir))) {
+            PRRTE_ERROR_LOG(PRRTE_ERROR);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        dirname = prrte_dirname(sink->fullpath);
+        if (0 != chdir(dirname)) {
+            PRRTE_ERROR_LOG(PRRTE_ERROR);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s write:handler unarchiving file %s with cmd: %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             sink->file, cmd));
+        if (0 != system(cmd)) {
+            PRRTE_ERROR_LOG(PRRTE_ERROR);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        if (0 != chdir(homedir)) {
+            PRRTE_ERROR_LOG(PRRTE_ERROR);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        free(dirname);
+        free(cmd);
+        /* setup the link points */
+        if (PRRTE_SUCCESS != (rc = link_archive(sink))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+        } else {
+            send_complete(sink->file, PRRTE_SUCCESS);
+        }
+    }
+}
+
 static void write_handler(int fd, short event, void *cbdata)
 {
     prrte_filem_raw_incoming_t *sink = (prrte_filem_raw_incoming_t*)cbdata;
     prrte_list_item_t *item;
     prrte_filem_raw_output_t *output;
     int num_written;
-    char *dirname, *cmd;
-    char homedir[MAXPATHLEN];
-    int rc;
 
     PRRTE_ACQUIRE_OBJECT(sink);
 
@@ -1134,61 +1813,10 @@ static void write_handler(int fd, short event, void *cbdata)
             /* close the file descriptor */
             close(sink->fd);
             sink->fd = -1;
-            if (PRRTE_FILEM_TYPE_FILE == sink->type ||
-                PRRTE_FILEM_TYPE_EXE == sink->type) {
-                /* just link to the top as this will be the
-                 * name we will want in each proc's session dir
-                 */
-                prrte_argv_append_nosize(&sink->link_pts, sink->top);
-                send_complete(sink->file, PRRTE_SUCCESS);
-            } else {
-                /* unarchive the file */
-                if (PRRTE_FILEM_TYPE_TAR == sink->type) {
-                    prrte_asprintf(&cmd, "tar xf %s", sink->file);
-                } else if (PRRTE_FILEM_TYPE_BZIP == sink->type) {
-                    prrte_asprintf(&cmd, "tar xjf %s", sink->file);
-                } else if (PRRTE_FILEM_TYPE_GZIP == sink->type) {
-                    prrte_asprintf(&cmd, "tar xzf %s", sink->file);
-                } else {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (NULL == getcwd(homedir, sizeof(homedir))) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                dirname = prrte_dirname(sink->fullpath);
-                if (0 != chdir(dirname)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                                     "%s write:handler unarchiving file %s with cmd: %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     sink->file, cmd));
-                if (0 != system(cmd)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (0 != chdir(homedir)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                free(dirname);
-                free(cmd);
-                /* setup the link points */
-                if (PRRTE_SUCCESS != (rc = link_archive(sink))) {
-                    PRRTE_ERROR_LOG(rc);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                } else {
-                    send_complete(sink->file, PRRTE_SUCCESS);
-                }
-            }
+            PRRTE_RELEASE(output);
+            /* keep the content for later jobs */
+            cache_insert(sink);
+            finish_incoming(sink);
             return;
         }
         num_written = write(sink->fd, output->data, output->numbytes);
@@ -1242,6 +1870,25 @@ static void xfer_construct(prrte_filem_raw_xfer_t *ptr)
     ptr->outbound = NULL;
     ptr->app_idx = 0;
     ptr->pending = false;
+    ptr->id = -1;
+    ptr->fd = -1;
+    ptr->map = NULL;
+    ptr->buf = NULL;
+    ptr->size = 0;
+    ptr->mtime = 0;
+    ptr->offset = 0;
+    ptr->sig = NULL;
+    ptr->key = NULL;
+    ptr->announced = false;
+    ptr->direct = false;
+    ptr->need = NULL;
+    ptr->nneed = 0;
+    ptr->level = (0 < prrte_filem_raw_compress_level) ? prrte_filem_raw_compress_level : 1;
+    ptr->probe = 0;
+    ptr->wirebytes = 0;
+    ptr->cmpusec = 0.0;
+    ptr->start.tv_sec = 0;
+    ptr->start.tv_usec = 0;
     ptr->src = NULL;
     ptr->file = NULL;
     ptr->nchunk = 0;
@@ -1253,6 +1900,16 @@ static void xfer_destruct(prrte_filem_raw_xfer_t *ptr)
     if (ptr->pending) {
         prrte_event_del(&ptr->ev);
     }
+    xfer_close(ptr);
+    if (NULL != ptr->sig) {
+        PRRTE_RELEASE(ptr->sig);
+    }
+    if (NULL != ptr->key) {
+        free(ptr->key);
+    }
+    if (NULL != ptr->need) {
+        free(ptr->need);
+    }
     if (NULL != ptr->src) {
         free(ptr->src);
     }
@@ -1288,7 +1945,10 @@ static void in_construct(prrte_filem_raw_incoming_t *ptr)
 {
     ptr->app_idx = 0;
     ptr->pending = false;
+    ptr->id = -1;
     ptr->fd = -1;
+    ptr->key = NULL;
+    ptr->cached = false;
     ptr->file = NULL;
     ptr->top = NULL;
     ptr->fullpath = NULL;
@@ -1305,6 +1965,9 @@ static void in_destruct(prrte_filem_raw_incoming_t *ptr)
     if (0 <= ptr->fd) {
         close(ptr->fd);
     }
+    if (NULL != ptr->key) {
+        free(ptr->key);
+    }
     if (NULL != ptr->file) {
         free(ptr->file);
     }
@@ -1327,7 +1990,34 @@ PRRTE_CLASS_INSTANCE(prrte_filem_raw_incoming_t,
 static void output_construct(prrte_filem_raw_output_t *ptr)
 {
     ptr->numbytes = 0;
+    ptr->data = NULL;
+}
+static void output_destruct(prrte_filem_raw_output_t *ptr)
+{
+    if (NULL != ptr->data) {
+        free(ptr->data);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_filem_raw_output_t,
                    prrte_list_item_t,
-                   output_construct, NULL);
+                   output_construct, output_destruct);
+
+static void cache_construct(prrte_filem_raw_cache_t *ptr)
+{
+    ptr->key = NULL;
+    ptr->path = NULL;
+    ptr->size = 0;
+    ptr->mtime = 0;
+}
+static void cache_destruct(prrte_filem_raw_cache_t *ptr)
+{
+    if (NULL != ptr->key) {
+        free(ptr->key);
+    }
+    if (NULL != ptr->path) {
+        free(ptr->path);
+    }
+}
+PRRTE_CLASS_INSTANCE(prrte_filem_raw_cache_t,
+                   prrte_list_item_t,
+                   cache_construct, cache_destruct);
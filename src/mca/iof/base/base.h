@@ -46,9 +46,12 @@
 #include <unistd.h>
 #endif
 #include <signal.h>
+#include <limits.h>
 
 #include "src/class/prrte_list.h"
 #include "src/class/prrte_bitmap.h"
+#include "src/class/prrte_hash_table.h"
+#include "src/class/prrte_ring_buffer.h"
 #include "src/mca/mca.h"
 #include "src/event/event-internal.h"
 #include "src/util/fd.h"
@@ -82,6 +85,11 @@ PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_job_t);
  * Maximum size of single msg
  */
 #define PRRTE_IOF_BASE_MSG_MAX           4096
+/*
+ * Largest single read from a proc's output - reads start at
+ * PRRTE_IOF_BASE_MSG_MAX and grow toward this while they fill up
+ */
+#define PRRTE_IOF_BASE_READ_MAX         65536
 #define PRRTE_IOF_BASE_TAG_MAX             50
 #define PRRTE_IOF_BASE_TAGGED_OUT_MAX    8192
 #define PRRTE_IOF_MAX_INPUT_BUFFERS        50
@@ -94,6 +102,10 @@ typedef struct {
     struct timeval tv;
     int fd;
     prrte_list_t outputs;
+    /* ask the sources feeding this sink to hold off while it is
+     * backed up, and whether we currently have done so */
+    bool throttle;
+    bool xoff;
 } prrte_iof_write_event_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_write_event_t);
 
@@ -120,6 +132,8 @@ typedef struct {
     bool active;
     bool always_readable;
     prrte_iof_sink_t *sink;
+    /* number of bytes to ask for on the next read */
+    int rdsize;
 } prrte_iof_read_event_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_read_event_t);
 
@@ -131,9 +145,24 @@ typedef struct {
     prrte_iof_read_event_t *revstderr;
     prrte_list_t *subscribers;
     bool copy;
+    /* "[jobid,vpid]<stream>:" output tags for stdout, stderr
+     * and stddiag - built the first time each one is needed */
+    char *tags[3];
+    /* recent output retained in place of forwarding it */
+    prrte_ring_buffer_t *tail;
+    /* deliver the rest of the tail once the channels close */
+    bool tail_dump;
 } prrte_iof_proc_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_proc_t);
 
+typedef struct {
+    prrte_object_t super;
+    prrte_iof_tag_t tag;
+    int numbytes;
+    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
+} prrte_iof_tail_chunk_t;
+PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_tail_chunk_t);
+
 typedef struct {
     prrte_list_item_t super;
     char data[PRRTE_IOF_BASE_TAGGED_OUT_MAX];
@@ -142,8 +171,16 @@ typedef struct {
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_write_output_t);
 
 /* the iof globals struct */
+/* called with true when the first throttled sink backs up, and
+ * with false once the last of them has drained */
+typedef void (*prrte_iof_base_xonxoff_fn_t)(bool xoff);
+
 struct prrte_iof_base_t {
     size_t                  output_limit;
+    size_t                  output_hwm;
+    size_t                  output_lwm;
+    int                     num_xoff;
+    prrte_iof_base_xonxoff_fn_t xonxoff;
     prrte_iof_sink_t         *iof_write_stdout;
     prrte_iof_sink_t         *iof_write_stderr;
     bool                    redirect_app_stderr_to_stdout;
@@ -162,6 +199,13 @@ prrte_iof_base_fd_always_ready(int fd)
 
 #define PRRTE_IOF_SINK_BLOCKSIZE (1024)
 
+/* max number of queued outputs handed to a single writev */
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define PRRTE_IOF_SINK_IOV_MAX IOV_MAX
+#else
+#define PRRTE_IOF_SINK_IOV_MAX 1024
+#endif
+
 #define PRRTE_IOF_SINK_ACTIVATE(wev)                                     \
     do {                                                                \
         struct timeval *tv = NULL;                                      \
@@ -275,9 +319,24 @@ PRRTE_EXPORT extern prrte_iof_base_t prrte_iof_base;
 PRRTE_EXPORT int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_t stream,
                                              const unsigned char *data, int numbytes,
                                              prrte_iof_write_event_t *channel);
+PRRTE_EXPORT int prrte_iof_base_write_proc_output(prrte_iof_proc_t *proct, prrte_iof_tag_t stream,
+                                                  const unsigned char *data, int numbytes,
+                                                  prrte_iof_write_event_t *channel);
 PRRTE_EXPORT void prrte_iof_base_static_dump_output(prrte_iof_read_event_t *rev);
 PRRTE_EXPORT void prrte_iof_base_write_handler(int fd, short event, void *cbdata);
 
+/* proc records - components keep them on a list and index them
+ * by name in a proc table so they can be found without a list walk.
+ * A wild lookup falls back to a record covering all of the proc's
+ * job, or all jobs, if there isn't one for the proc itself */
+PRRTE_EXPORT prrte_iof_proc_t* prrte_iof_base_find_proc(prrte_proc_table_t *pt,
+                                                        const prrte_process_name_t *name,
+                                                        bool wild);
+PRRTE_EXPORT prrte_iof_proc_t* prrte_iof_base_add_proc(prrte_list_t *procs, prrte_proc_table_t *pt,
+                                                       const prrte_process_name_t *name);
+PRRTE_EXPORT void prrte_iof_base_remove_proc(prrte_list_t *procs, prrte_proc_table_t *pt,
+                                             prrte_iof_proc_t *proct);
+
 END_C_DECLS
 
 #endif /* MCA_IOF_BASE_H */
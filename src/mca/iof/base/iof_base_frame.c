@@ -72,6 +72,22 @@ static int prrte_iof_base_register(prrte_mca_base_register_flag_t flags)
                                        PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                        &prrte_iof_base.output_limit);
 
+    /* flow control of our stdout/stderr */
+    prrte_iof_base.output_hwm = 1024;
+    (void) prrte_mca_base_var_register("prrte", "iof", "base", "output_hwm",
+                                       "Backlog of output messages at which the sources of output are told to stop sending it until the backlog drains (0 => never stop them)",
+                                       PRRTE_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                       PRRTE_INFO_LVL_9,
+                                       PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prrte_iof_base.output_hwm);
+    prrte_iof_base.output_lwm = 256;
+    (void) prrte_mca_base_var_register("prrte", "iof", "base", "output_lwm",
+                                       "Backlog of output messages below which stopped sources of output are told to resume",
+                                       PRRTE_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                       PRRTE_INFO_LVL_9,
+                                       PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prrte_iof_base.output_lwm);
+
     /* Redirect application stderr to stdout (at source) */
     prrte_iof_base.redirect_app_stderr_to_stdout = false;
     (void) prrte_mca_base_var_register("prrte", "iof","base", "redirect_app_stderr_to_stdout",
@@ -123,6 +139,7 @@ static int prrte_iof_base_open(prrte_mca_base_open_flag_t flags)
             /* setup the stdout event */
             PRRTE_IOF_SINK_DEFINE(&prrte_iof_base.iof_write_stdout, PRRTE_PROC_MY_NAME,
                                  xmlfd, PRRTE_IOF_STDOUT, prrte_iof_base_write_handler);
+            prrte_iof_base.iof_write_stdout->wev->throttle = true;
             /* don't create a stderr event - all output will go to
              * the stdout channel
              */
@@ -130,9 +147,11 @@ static int prrte_iof_base_open(prrte_mca_base_open_flag_t flags)
             /* setup the stdout event */
             PRRTE_IOF_SINK_DEFINE(&prrte_iof_base.iof_write_stdout, PRRTE_PROC_MY_NAME,
                                  1, PRRTE_IOF_STDOUT, prrte_iof_base_write_handler);
+            prrte_iof_base.iof_write_stdout->wev->throttle = true;
             /* setup the stderr event */
             PRRTE_IOF_SINK_DEFINE(&prrte_iof_base.iof_write_stderr, PRRTE_PROC_MY_NAME,
                                  2, PRRTE_IOF_STDERR, prrte_iof_base_write_handler);
+            prrte_iof_base.iof_write_stderr->wev->throttle = true;
         }
 
         /* do NOT set these file descriptors to non-blocking. If we do so,
@@ -181,9 +200,20 @@ static void prrte_iof_base_proc_construct(prrte_iof_proc_t* ptr)
     ptr->revstderr = NULL;
     ptr->subscribers = NULL;
     ptr->copy = true;
+    memset(ptr->tags, 0, sizeof(ptr->tags));
+    ptr->tail = NULL;
+    ptr->tail_dump = false;
 }
 static void prrte_iof_base_proc_destruct(prrte_iof_proc_t* ptr)
 {
+    prrte_iof_tail_chunk_t *chunk;
+    int n;
+
+    for (n=0; n < 3; n++) {
+        if (NULL != ptr->tags[n]) {
+            free(ptr->tags[n]);
+        }
+    }
     if (NULL != ptr->stdinev) {
         PRRTE_RELEASE(ptr->stdinev);
     }
@@ -196,12 +226,28 @@ static void prrte_iof_base_proc_destruct(prrte_iof_proc_t* ptr)
     if (NULL != ptr->subscribers) {
         PRRTE_LIST_RELEASE(ptr->subscribers);
     }
+    if (NULL != ptr->tail) {
+        while (NULL != (chunk = (prrte_iof_tail_chunk_t*)prrte_ring_buffer_pop(ptr->tail))) {
+            PRRTE_RELEASE(chunk);
+        }
+        PRRTE_RELEASE(ptr->tail);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_iof_proc_t,
                    prrte_list_item_t,
                    prrte_iof_base_proc_construct,
                    prrte_iof_base_proc_destruct);
 
+static void prrte_iof_base_tail_chunk_construct(prrte_iof_tail_chunk_t *ptr)
+{
+    ptr->tag = 0;
+    ptr->numbytes = 0;
+}
+PRRTE_CLASS_INSTANCE(prrte_iof_tail_chunk_t,
+                   prrte_object_t,
+                   prrte_iof_base_tail_chunk_construct,
+                   NULL);
+
 
 static void prrte_iof_base_sink_construct(prrte_iof_sink_t* ptr)
 {
@@ -235,6 +281,7 @@ static void prrte_iof_base_read_event_construct(prrte_iof_read_event_t* rev)
     rev->active = false;
     rev->ev = prrte_event_alloc();
     rev->sink = NULL;
+    rev->rdsize = PRRTE_IOF_BASE_MSG_MAX;
     rev->tv.tv_sec = 0;
     rev->tv.tv_usec = 0;
 }
@@ -270,6 +317,8 @@ static void prrte_iof_base_write_event_construct(prrte_iof_write_event_t* wev)
     wev->pending = false;
     wev->always_writable = false;
     wev->fd = -1;
+    wev->throttle = false;
+    wev->xoff = false;
     PRRTE_CONSTRUCT(&wev->outputs, prrte_list_t);
     wev->ev = prrte_event_alloc();
     wev->tv.tv_sec = 0;
@@ -306,3 +355,52 @@ PRRTE_CLASS_INSTANCE(prrte_iof_write_event_t,
 PRRTE_CLASS_INSTANCE(prrte_iof_write_output_t,
                    prrte_list_item_t,
                    NULL, NULL);
+
+prrte_iof_proc_t* prrte_iof_base_find_proc(prrte_proc_table_t *pt,
+                                           const prrte_process_name_t *name,
+                                           bool wild)
+{
+    prrte_iof_proc_t *proct;
+    prrte_process_name_t nm;
+
+    if (PRRTE_SUCCESS == prrte_proc_table_get_value(pt, *name, (void**)&proct)) {
+        return proct;
+    }
+    if (!wild) {
+        return NULL;
+    }
+    nm.jobid = name->jobid;
+    nm.vpid = PRRTE_VPID_WILDCARD;
+    if (PRRTE_SUCCESS == prrte_proc_table_get_value(pt, nm, (void**)&proct)) {
+        return proct;
+    }
+    nm.jobid = PRRTE_JOBID_WILDCARD;
+    if (PRRTE_SUCCESS == prrte_proc_table_get_value(pt, nm, (void**)&proct)) {
+        return proct;
+    }
+    return NULL;
+}
+
+prrte_iof_proc_t* prrte_iof_base_add_proc(prrte_list_t *procs, prrte_proc_table_t *pt,
+                                          const prrte_process_name_t *name)
+{
+    prrte_iof_proc_t *proct;
+    int rc;
+
+    proct = PRRTE_NEW(prrte_iof_proc_t);
+    proct->name.jobid = name->jobid;
+    proct->name.vpid = name->vpid;
+    prrte_list_append(procs, &proct->super);
+    /* the list holds the reference - the table only indexes it */
+    if (PRRTE_SUCCESS != (rc = prrte_proc_table_set_value(pt, proct->name, proct))) {
+        PRRTE_ERROR_LOG(rc);
+    }
+    return proct;
+}
+
+void prrte_iof_base_remove_proc(prrte_list_t *procs, prrte_proc_table_t *pt,
+                                prrte_iof_proc_t *proct)
+{
+    prrte_list_remove_item(procs, &proct->super);
+    prrte_proc_table_remove_value(pt, proct->name);
+}
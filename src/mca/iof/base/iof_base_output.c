@@ -37,6 +37,7 @@
 #include <errno.h>
 
 #include "src/util/output.h"
+#include "src/util/printf.h"
 
 #include "src/util/name_fns.h"
 #include "src/threads/threads.h"
@@ -46,15 +47,80 @@
 
 #include "src/mca/iof/base/base.h"
 
+/* copy as much of src as fits below max into dst at offset k,
+ * returning the new offset */
+static inline int iof_append(char *dst, int k, int max, const char *src, int len)
+{
+    if (max - k < len) {
+        len = (max - k < 0) ? 0 : max - k;
+    }
+    memcpy(&dst[k], src, len);
+    return k + len;
+}
+
+/* chars that must be escaped in xml output */
+static inline bool iof_xml_special(unsigned char c)
+{
+    return (c < 32 || c > 127 || '&' == c || '<' == c || '>' == c);
+}
+
+/* the timestamp used to prefix output - output arrives far more
+ * often than once a second, so only reformat it when the second
+ * changes */
+static time_t iof_ts_time = (time_t)-1;
+static char iof_ts[PRRTE_IOF_BASE_TAG_MAX];
+static int iof_ts_len = 0;
+
+static void iof_timestamp(void)
+{
+    time_t mytime;
+    char *cptr;
+
+    /* get the timestamp */
+    time(&mytime);
+    if (mytime == iof_ts_time) {
+        return;
+    }
+    iof_ts_time = mytime;
+    cptr = ctime(&mytime);
+    iof_ts_len = strlen(cptr) - 1;  /* remove trailing newline */
+    if (PRRTE_IOF_BASE_TAG_MAX <= iof_ts_len) {
+        iof_ts_len = PRRTE_IOF_BASE_TAG_MAX - 1;
+    }
+    memcpy(iof_ts, cptr, iof_ts_len);
+    iof_ts[iof_ts_len] = '\0';
+}
+
+static int write_output(const prrte_process_name_t *name, prrte_iof_proc_t *proct,
+                        prrte_iof_tag_t stream, const unsigned char *data, int numbytes,
+                        prrte_iof_write_event_t *channel);
+
 int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_t stream,
                                const unsigned char *data, int numbytes,
                                prrte_iof_write_event_t *channel)
 {
-    char starttag[PRRTE_IOF_BASE_TAG_MAX], endtag[PRRTE_IOF_BASE_TAG_MAX], *suffix;
+    return write_output(name, NULL, stream, data, numbytes, channel);
+}
+
+/* same as prrte_iof_base_write_output, but the output tags are
+ * built once and kept on the proc */
+int prrte_iof_base_write_proc_output(prrte_iof_proc_t *proct, prrte_iof_tag_t stream,
+                                     const unsigned char *data, int numbytes,
+                                     prrte_iof_write_event_t *channel)
+{
+    return write_output(&proct->name, proct, stream, data, numbytes, channel);
+}
+
+static int write_output(const prrte_process_name_t *name, prrte_iof_proc_t *proct,
+                        prrte_iof_tag_t stream, const unsigned char *data, int numbytes,
+                        prrte_iof_write_event_t *channel)
+{
+    char starttag[PRRTE_IOF_BASE_TAG_MAX], endtag[PRRTE_IOF_BASE_TAG_MAX], *suffix, *tag = NULL;
     prrte_iof_write_output_t *output;
     int i, j, k, starttaglen, endtaglen, num_buffered;
     bool endtagged;
-    char qprint[10];
+    const char *qprint, *nl;
+    char qbuf[8];
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                          "%s write:output setting up to write %d bytes to %s for %s on fd %d",
@@ -63,6 +129,22 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
                          PRRTE_NAME_PRINT(name),
                          (NULL == channel) ? -1 : channel->fd));
 
+    /* output records hold at most one message worth of data, so
+     * hand over larger reads a message at a time */
+    if (PRRTE_IOF_BASE_MSG_MAX < numbytes) {
+        for (i=0; i < numbytes; i += PRRTE_IOF_BASE_MSG_MAX) {
+            j = numbytes - i;
+            if (PRRTE_IOF_BASE_MSG_MAX < j) {
+                j = PRRTE_IOF_BASE_MSG_MAX;
+            }
+            num_buffered = write_output(name, proct, stream, data + i, j, channel);
+            if (num_buffered < 0) {
+                break;
+            }
+        }
+        return num_buffered;
+    }
+
     /* setup output object */
     output = PRRTE_NEW(prrte_iof_write_output_t);
 
@@ -104,35 +186,51 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
         goto construct;
     }
 
+    if (prrte_tag_output) {
+        if (NULL == proct) {
+            snprintf(endtag, PRRTE_IOF_BASE_TAG_MAX, "[%s,%s]<%s>:",
+                     PRRTE_LOCAL_JOBID_PRINT(name->jobid),
+                     PRRTE_VPID_PRINT(name->vpid), suffix);
+            tag = endtag;
+        } else {
+            /* stdout, stderr or stddiag */
+            i = (PRRTE_IOF_STDOUT & stream) ? 0 : ((PRRTE_IOF_STDERR & stream) ? 1 : 2);
+            if (NULL == proct->tags[i]) {
+                prrte_asprintf(&proct->tags[i], "[%s,%s]<%s>:",
+                               PRRTE_LOCAL_JOBID_PRINT(name->jobid),
+                               PRRTE_VPID_PRINT(name->vpid), suffix);
+            }
+            tag = proct->tags[i];
+        }
+    }
+
     /* if we are to timestamp output, start the tag with that */
     if (prrte_timestamp_output) {
-        time_t mytime;
-        char *cptr;
-        /* get the timestamp */
-        time(&mytime);
-        cptr = ctime(&mytime);
-        cptr[strlen(cptr)-1] = '\0';  /* remove trailing newline */
-
+        iof_timestamp();
+        memcpy(starttag, iof_ts, iof_ts_len);
+        k = iof_ts_len;
         if (prrte_tag_output) {
             /* if we want it tagged as well, use both */
-            snprintf(starttag, PRRTE_IOF_BASE_TAG_MAX, "%s[%s,%s]<%s>:",
-                     cptr, PRRTE_LOCAL_JOBID_PRINT(name->jobid),
-                     PRRTE_VPID_PRINT(name->vpid), suffix);
+            j = strlen(tag);
+            k = iof_append(starttag, k, PRRTE_IOF_BASE_TAG_MAX-1, tag, j);
         } else {
             /* only use timestamp */
-            snprintf(starttag, PRRTE_IOF_BASE_TAG_MAX, "%s<%s>:", cptr, suffix);
+            k = iof_append(starttag, k, PRRTE_IOF_BASE_TAG_MAX-1, "<", 1);
+            k = iof_append(starttag, k, PRRTE_IOF_BASE_TAG_MAX-1, suffix, strlen(suffix));
+            k = iof_append(starttag, k, PRRTE_IOF_BASE_TAG_MAX-1, ">:", 2);
         }
+        starttag[k] = '\0';
         /* no endtag for this option */
-        memset(endtag, '\0', PRRTE_IOF_BASE_TAG_MAX);
+        endtag[0] = '\0';
         goto construct;
     }
 
     if (prrte_tag_output) {
-        snprintf(starttag, PRRTE_IOF_BASE_TAG_MAX, "[%s,%s]<%s>:",
-                 PRRTE_LOCAL_JOBID_PRINT(name->jobid),
-                 PRRTE_VPID_PRINT(name->vpid), suffix);
+        j = strlen(tag);
+        k = iof_append(starttag, 0, PRRTE_IOF_BASE_TAG_MAX-1, tag, j);
+        starttag[k] = '\0';
         /* no endtag for this option */
-        memset(endtag, '\0', PRRTE_IOF_BASE_TAG_MAX);
+        endtag[0] = '\0';
         goto construct;
     }
 
@@ -154,99 +252,71 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
     endtaglen = strlen(endtag);
     endtagged = false;
     /* start with the tag */
-    for (j=0, k=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-        output->data[k++] = starttag[j];
-    }
-    /* cycle through the data looking for <cr>
-     * and replace those with the tag
-     */
+    k = iof_append(output->data, 0, PRRTE_IOF_BASE_TAGGED_OUT_MAX, starttag, starttaglen);
+    /* copy the data over a run at a time, breaking it at each <cr>
+     * (and, for xml, at each char that needs escaping) to add the tags */
     for (i=0; i < numbytes && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; i++) {
         if (prrte_xml_output) {
+            for (j=i; j < numbytes && !iof_xml_special(data[j]); j++);
+        } else {
+            nl = memchr(&data[i], '\n', numbytes - i);
+            j = (NULL == nl) ? numbytes : (int)(nl - (const char*)data);
+        }
+        k = iof_append(output->data, k, PRRTE_IOF_BASE_TAGGED_OUT_MAX, (const char*)&data[i], j - i);
+        i = j;
+        if (numbytes <= i || PRRTE_IOF_BASE_TAGGED_OUT_MAX <= k) {
+            break;
+        }
+        if (prrte_xml_output) {
+            /* escape the char - anything non-printable goes by number */
             if ('&' == data[i]) {
-                if (k+5 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&amp;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                qprint = "&amp;";
             } else if ('<' == data[i]) {
-                if (k+4 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&lt;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                qprint = "&lt;";
             } else if ('>' == data[i]) {
-                if (k+4 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&gt;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
-            } else if (data[i] < 32 || data[i] > 127) {
-                /* this is a non-printable character, so escape it too */
-                if (k+7 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&#%03d;", (int)data[i]);
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
-                /* if this was a \n, then we also need to break the line with the end tag */
-                if ('\n' == data[i] && (k+endtaglen+1) < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    /* we need to break the line with the end tag */
-                    for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-                        output->data[k++] = endtag[j];
-                    }
-                    /* move the <cr> over */
-                    output->data[k++] = '\n';
-                    /* if this isn't the end of the data buffer, add a new start tag */
-                    if (i < numbytes-1 && (k+starttaglen) < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                        for (j=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                            output->data[k++] = starttag[j];
-                            endtagged = false;
-                        }
-                    } else {
-                        endtagged = true;
-                    }
-                }
+                qprint = "&gt;";
             } else {
-                output->data[k++] = data[i];
+                qbuf[0] = '&';
+                qbuf[1] = '#';
+                qbuf[2] = '0' + data[i] / 100;
+                qbuf[3] = '0' + (data[i] / 10) % 10;
+                qbuf[4] = '0' + data[i] % 10;
+                qbuf[5] = ';';
+                qbuf[6] = '\0';
+                qprint = qbuf;
             }
-        } else {
-            if ('\n' == data[i]) {
-                /* we need to break the line with the end tag */
-                for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-                    output->data[k++] = endtag[j];
-                }
-                /* move the <cr> over */
-                output->data[k++] = '\n';
-                /* if this isn't the end of the data buffer, add a new start tag */
-                if (i < numbytes-1) {
-                    for (j=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                        output->data[k++] = starttag[j];
-                        endtagged = false;
-                    }
-                } else {
-                    endtagged = true;
-                }
-            } else {
-                output->data[k++] = data[i];
+            j = strlen(qprint);
+            if (k + j + (qprint == qbuf) >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                output->numbytes = k;
+                goto process;
+            }
+            memcpy(&output->data[k], qprint, j);
+            k += j;
+            /* if this was a \n, then we also need to break the line with the end tag */
+            if ('\n' != data[i] || (k+endtaglen+1) >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
+                continue;
             }
         }
+        /* we need to break the line with the end tag */
+        k = iof_append(output->data, k, PRRTE_IOF_BASE_TAGGED_OUT_MAX-1, endtag, endtaglen);
+        /* move the <cr> over */
+        output->data[k++] = '\n';
+        /* if this isn't the end of the data buffer, add a new start tag */
+        if (i < numbytes-1 &&
+            (!prrte_xml_output || (k+starttaglen) < PRRTE_IOF_BASE_TAGGED_OUT_MAX)) {
+            j = k;
+            k = iof_append(output->data, k, PRRTE_IOF_BASE_TAGGED_OUT_MAX, starttag, starttaglen);
+            if (j < k) {
+                endtagged = false;
+            }
+        } else {
+            endtagged = true;
+        }
     }
     if (!endtagged && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
         /* need to add an endtag */
-        for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-            output->data[k++] = endtag[j];
-        }
+        k = iof_append(output->data, k, PRRTE_IOF_BASE_TAGGED_OUT_MAX-1, endtag, endtaglen);
         output->data[k] = '\n';
     }
     output->numbytes = k;
@@ -258,6 +328,19 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
     /* record how big the buffer is */
     num_buffered = prrte_list_get_size(&channel->outputs);
 
+    /* if we are falling behind, have the sources hold off */
+    if (channel->throttle && !channel->xoff &&
+        0 < prrte_iof_base.output_hwm && prrte_iof_base.output_hwm <= (size_t)num_buffered) {
+        channel->xoff = true;
+        if (0 == prrte_iof_base.num_xoff++ && NULL != prrte_iof_base.xonxoff) {
+            PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                                 "%s write:output backlog of %d on fd %d - xoff",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                 num_buffered, channel->fd));
+            prrte_iof_base.xonxoff(true);
+        }
+    }
+
     /* is the write event issued? */
     if (!channel->pending) {
         /* issue it */
@@ -296,13 +379,31 @@ void prrte_iof_base_static_dump_output(prrte_iof_read_event_t *rev)
     }
 }
 
+/* let the sources resume once a sink we held them off for
+ * has worked off most of its backlog */
+static void iof_drained(prrte_iof_write_event_t *wev)
+{
+    if (!wev->xoff ||
+        prrte_iof_base.output_lwm < prrte_list_get_size(&wev->outputs)) {
+        return;
+    }
+    wev->xoff = false;
+    if (0 == --prrte_iof_base.num_xoff && NULL != prrte_iof_base.xonxoff) {
+        PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                             "%s write:handler backlog on fd %d drained - xon",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), wev->fd));
+        prrte_iof_base.xonxoff(false);
+    }
+}
+
 void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
 {
     prrte_iof_sink_t *sink = (prrte_iof_sink_t*)cbdata;
     prrte_iof_write_event_t *wev = sink->wev;
     prrte_list_item_t *item;
     prrte_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    struct iovec iov[PRRTE_IOF_SINK_IOV_MAX];
+    int num_written, total_written = 0, niov, nbytes;
 
     PRRTE_ACQUIRE_OBJECT(sink);
 
@@ -311,18 +412,33 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                          wev->fd));
 
-    while (NULL != (item = prrte_list_remove_first(&wev->outputs))) {
-        output = (prrte_iof_write_output_t*)item;
-        if (0 == output->numbytes) {
+    while (!prrte_list_is_empty(&wev->outputs)) {
+        /* gather as many of the queued outputs as we can into
+         * a single write, stopping at any close marker */
+        niov = 0;
+        nbytes = 0;
+        PRRTE_LIST_FOREACH(output, &wev->outputs, prrte_iof_write_output_t) {
+            if (0 == output->numbytes) {
+                break;
+            }
+            iov[niov].iov_base = output->data;
+            iov[niov].iov_len = output->numbytes;
+            nbytes += output->numbytes;
+            if (PRRTE_IOF_SINK_IOV_MAX == ++niov ||
+                (wev->always_writable && PRRTE_IOF_SINK_BLOCKSIZE <= total_written + nbytes)) {
+                break;
+            }
+        }
+        if (0 == niov) {
             /* indicates we are to close this stream */
+            item = prrte_list_remove_first(&wev->outputs);
+            PRRTE_RELEASE(item);
             PRRTE_RELEASE(sink);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        num_written = writev(wev->fd, iov, niov);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                prrte_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (prrte_iof_base.output_limit < prrte_list_get_size(&wev->outputs)) {
                     prrte_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -337,15 +453,27 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
-            PRRTE_RELEASE(output);
+            item = prrte_list_remove_first(&wev->outputs);
+            PRRTE_RELEASE(item);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
+        }
+        total_written += num_written;
+        /* release everything that went out */
+        while (0 < niov) {
+            output = (prrte_iof_write_output_t*)prrte_list_get_first(&wev->outputs);
+            if (num_written < output->numbytes) {
+                break;
+            }
+            num_written -= output->numbytes;
+            item = prrte_list_remove_first(&wev->outputs);
+            PRRTE_RELEASE(item);
+            --niov;
+        }
+        if (0 < niov) {
             /* incomplete write - adjust data to avoid duplicate output */
             memmove(output->data, &output->data[num_written], output->numbytes - num_written);
             /* adjust the number of bytes remaining to be written */
             output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            prrte_list_prepend(&wev->outputs, item);
             /* if the list is getting too large, abort */
             if (prrte_iof_base.output_limit < prrte_list_get_size(&wev->outputs)) {
                 prrte_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -357,9 +485,7 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
              */
             goto NEXT_CALL;
         }
-        PRRTE_RELEASE(output);
 
-        total_written += num_written;
         if(wev->always_writable && (PRRTE_IOF_SINK_BLOCKSIZE <= total_written)){
             /* If this is a regular file it will never tell us it will block
              * Write no more than PRRTE_IOF_REGULARF_BLOCK at a time allowing
@@ -370,8 +496,10 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
     }
   ABORT:
     wev->pending = false;
+    iof_drained(wev);
     PRRTE_POST_OBJECT(wev);
     return;
 NEXT_CALL:
+    iof_drained(wev);
     PRRTE_IOF_SINK_ACTIVATE(wev);
 }
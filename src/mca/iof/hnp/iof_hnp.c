@@ -85,6 +85,11 @@ static int hnp_ft_event(int state);
 static int push_stdin(const prrte_process_name_t* dst_name,
                       uint8_t *data, size_t sz);
 
+static int hnp_tail(const prrte_process_name_t* peer,
+                    const prrte_process_name_t* requestor);
+
+static void hnp_xonxoff(bool xoff);
+
 /* The API's in this module are solely used to support LOCAL
  * procs - i.e., procs that are co-located to the HNP. Remote
  * procs interact with the HNP's IOF via the HNP's receive function,
@@ -100,7 +105,8 @@ prrte_iof_base_module_t prrte_iof_hnp_module = {
     .complete = hnp_complete,
     .finalize = finalize,
     .ft_event = hnp_ft_event,
-    .push_stdin = push_stdin
+    .push_stdin = push_stdin,
+    .tail = hnp_tail
 };
 
 /* Initialize the module */
@@ -114,9 +120,23 @@ static int init(void)
                             PRRTE_RML_PERSISTENT,
                             prrte_iof_hnp_recv,
                             NULL);
+    /* and for our copy of anything xcast to the daemons */
+    prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD,
+                            PRRTE_RML_TAG_IOF_PROXY,
+                            PRRTE_RML_PERSISTENT,
+                            prrte_iof_hnp_recv_xcast,
+                            NULL);
 
     PRRTE_CONSTRUCT(&prrte_iof_hnp_component.procs, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_iof_hnp_component.proc_table, prrte_proc_table_t);
+    prrte_proc_table_init(&prrte_iof_hnp_component.proc_table, 16, 1024);
     prrte_iof_hnp_component.stdinev = NULL;
+    prrte_iof_hnp_component.xoff = false;
+    prrte_iof_base.xonxoff = hnp_xonxoff;
+    prrte_iof_hnp_component.dcmp_msgs = 0;
+    prrte_iof_hnp_component.dcmp_inbytes = 0;
+    prrte_iof_hnp_component.dcmp_outbytes = 0;
+    prrte_iof_hnp_component.dcmp_usec = 0;
 
     return PRRTE_SUCCESS;
 }
@@ -142,7 +162,7 @@ static int hnp_push(const prrte_process_name_t* dst_name, prrte_iof_tag_t src_ta
     prrte_job_t *jdata;
     prrte_iof_proc_t *proct, *pptr;
     int flags, rc;
-    prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
+    prrte_process_name_t wild;
 
     /* don't do this if the dst vpid is invalid or the fd is negative! */
     if (PRRTE_VPID_INVALID == dst_name->vpid || fd < 0) {
@@ -155,19 +175,13 @@ static int hnp_push(const prrte_process_name_t* dst_name, prrte_iof_tag_t src_ta
                          fd, PRRTE_NAME_PRINT(dst_name)));
 
     /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
+    proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, dst_name, false);
+    if (NULL == proct) {
+        /* if we get here, then we don't yet have this proc in our list */
+        proct = prrte_iof_base_add_proc(&prrte_iof_hnp_component.procs,
+                                        &prrte_iof_hnp_component.proc_table, dst_name);
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = dst_name->jobid;
-    proct->name.vpid = dst_name->vpid;
-    prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
 
-  SETUP:
     /* set the file descriptor to non-blocking - do this before we setup
      * and activate the read event in case it fires right away
      */
@@ -207,14 +221,12 @@ static int hnp_push(const prrte_process_name_t* dst_name, prrte_iof_tag_t src_ta
         if (proct->copy) {
             /* see if there are any wildcard subscribers out there that
              * apply to us */
-            PRRTE_LIST_FOREACH(pptr, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-                if (dst_name->jobid == pptr->name.jobid &&
-                    PRRTE_VPID_WILDCARD == pptr->name.vpid &&
-                    NULL != pptr->subscribers) {
-                    PRRTE_RETAIN(pptr->subscribers);
-                    proct->subscribers = pptr->subscribers;
-                    break;
-                }
+            wild.jobid = dst_name->jobid;
+            wild.vpid = PRRTE_VPID_WILDCARD;
+            pptr = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, &wild, false);
+            if (NULL != pptr && NULL != pptr->subscribers) {
+                PRRTE_RETAIN(pptr->subscribers);
+                proct->subscribers = pptr->subscribers;
             }
         }
         PRRTE_IOF_READ_ACTIVATE(proct->revstdout);
@@ -235,7 +247,9 @@ static int hnp_push(const prrte_process_name_t* dst_name, prrte_iof_tag_t src_ta
 static int push_stdin(const prrte_process_name_t* dst_name,
                       uint8_t *data, size_t sz)
 {
-    prrte_iof_proc_t *proct, *pptr;
+    prrte_iof_proc_t *proct;
+    prrte_process_name_t host, target;
+    size_t n;
     int rc;
     prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
 
@@ -250,15 +264,28 @@ static int push_stdin(const prrte_process_name_t* dst_name,
                           PRRTE_NAME_PRINT(dst_name),
                           sz));
 
-    /* do we already have this process in our list? */
-    proct = NULL;
-    PRRTE_LIST_FOREACH(pptr, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &pptr->name, dst_name)) {
-            /* found it */
-            proct = pptr;
-        }
+    /* if this goes to all procs in the job, send a single copy
+     * of each fragment down the daemon tree - every daemon, us
+     * included, hands it to the stdin of its own local procs */
+    if (PRRTE_VPID_WILDCARD == dst_name->vpid) {
+        host.jobid = PRRTE_PROC_MY_NAME->jobid;
+        host.vpid = PRRTE_VPID_WILDCARD;
+        target = *dst_name;
+        do {
+            n = (PRRTE_IOF_BASE_MSG_MAX < sz) ? PRRTE_IOF_BASE_MSG_MAX : sz;
+            if (PRRTE_SUCCESS != (rc = prrte_iof_hnp_send_data_to_endpoint(&host, &target, PRRTE_IOF_STDIN,
+                                                                          data, n))) {
+                return rc;
+            }
+            data += n;
+            sz -= n;
+        } while (0 < sz);
+        return PRRTE_SUCCESS;
     }
-    if (NULL == proct) {
+
+    /* do we already have this process in our list? */
+    proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, dst_name, false);
+    if (NULL == proct || NULL == proct->stdinev) {
         return PRRTE_ERR_NOT_FOUND;
     }
 
@@ -318,7 +345,6 @@ static int hnp_pull(const prrte_process_name_t* dst_name,
                     int fd)
 {
     prrte_iof_proc_t *proct;
-    prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
     int flags;
 
     /* this is a local call - only stdin is supported */
@@ -343,19 +369,13 @@ static int hnp_pull(const prrte_process_name_t* dst_name,
     }
 
     /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
+    proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, dst_name, false);
+    if (NULL == proct) {
+        /* if we get here, then we don't yet have this proc in our list */
+        proct = prrte_iof_base_add_proc(&prrte_iof_hnp_component.procs,
+                                        &prrte_iof_hnp_component.proc_table, dst_name);
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = dst_name->jobid;
-    proct->name.vpid = dst_name->vpid;
-    prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
 
-  SETUP:
     PRRTE_IOF_SINK_DEFINE(&proct->stdinev, dst_name, fd, PRRTE_IOF_STDIN,
                          stdin_write_handler);
     proct->stdinev->daemon.jobid = PRRTE_PROC_MY_NAME->jobid;
@@ -372,44 +392,42 @@ static int hnp_close(const prrte_process_name_t* peer,
                      prrte_iof_tag_t source_tag)
 {
     prrte_iof_proc_t* proct;
-    prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                           "%s iof:hnp closing connection to process %s",
                           PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                           PRRTE_NAME_PRINT(peer)));
 
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, peer)) {
-            if (PRRTE_IOF_STDIN & source_tag) {
-                if (NULL != proct->stdinev) {
-                    PRRTE_RELEASE(proct->stdinev);
-                }
-                proct->stdinev = NULL;
-            }
-            if ((PRRTE_IOF_STDOUT & source_tag) ||
-                (PRRTE_IOF_STDMERGE & source_tag)) {
-                if (NULL != proct->revstdout) {
-                    prrte_iof_base_static_dump_output(proct->revstdout);
-                    PRRTE_RELEASE(proct->revstdout);
-                }
-                proct->revstdout = NULL;
+    proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, peer, false);
+    if (NULL != proct) {
+        if (PRRTE_IOF_STDIN & source_tag) {
+            if (NULL != proct->stdinev) {
+                PRRTE_RELEASE(proct->stdinev);
             }
-            if (PRRTE_IOF_STDERR & source_tag) {
-                if (NULL != proct->revstderr) {
-                    prrte_iof_base_static_dump_output(proct->revstderr);
-                    PRRTE_RELEASE(proct->revstderr);
-                }
-                proct->revstderr = NULL;
+            proct->stdinev = NULL;
+        }
+        if ((PRRTE_IOF_STDOUT & source_tag) ||
+            (PRRTE_IOF_STDMERGE & source_tag)) {
+            if (NULL != proct->revstdout) {
+                prrte_iof_base_static_dump_output(proct->revstdout);
+                PRRTE_RELEASE(proct->revstdout);
             }
-            /* if we closed them all, then remove this proc */
-            if (NULL == proct->stdinev &&
-                NULL == proct->revstdout &&
-                NULL == proct->revstderr) {
-                prrte_list_remove_item(&prrte_iof_hnp_component.procs, &proct->super);
-                PRRTE_RELEASE(proct);
+            proct->revstdout = NULL;
+        }
+        if (PRRTE_IOF_STDERR & source_tag) {
+            if (NULL != proct->revstderr) {
+                prrte_iof_base_static_dump_output(proct->revstderr);
+                PRRTE_RELEASE(proct->revstderr);
             }
-            break;
+            proct->revstderr = NULL;
+        }
+        /* if we closed them all, then remove this proc */
+        if (NULL == proct->stdinev &&
+            NULL == proct->revstdout &&
+            NULL == proct->revstderr) {
+            prrte_iof_base_remove_proc(&prrte_iof_hnp_component.procs,
+                                       &prrte_iof_hnp_component.proc_table, proct);
+            PRRTE_RELEASE(proct);
         }
     }
     return PRRTE_SUCCESS;
@@ -422,7 +440,8 @@ static void hnp_complete(const prrte_job_t *jdata)
     /* cleanout any lingering sinks */
     PRRTE_LIST_FOREACH_SAFE(proct, next, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
         if (jdata->jobid == proct->name.jobid) {
-            prrte_list_remove_item(&prrte_iof_hnp_component.procs, &proct->super);
+            prrte_iof_base_remove_proc(&prrte_iof_hnp_component.procs,
+                                       &prrte_iof_hnp_component.proc_table, proct);
             if (NULL != proct->revstdout) {
                 prrte_iof_base_static_dump_output(proct->revstdout);
                 PRRTE_RELEASE(proct->revstdout);
@@ -493,10 +512,87 @@ static int finalize(void)
         PRRTE_RELEASE(proct);
     }
     PRRTE_DESTRUCT(&prrte_iof_hnp_component.procs);
+    prrte_proc_table_remove_all(&prrte_iof_hnp_component.proc_table);
+    PRRTE_DESTRUCT(&prrte_iof_hnp_component.proc_table);
+
+    if (0 < prrte_iof_hnp_component.dcmp_msgs) {
+        prrte_output_verbose(1, prrte_iof_base_framework.framework_output,
+                             "%s iof:hnp decompressed %lu msgs: %lu bytes -> %lu bytes (%.1f%%) in %lu usec",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             (unsigned long)prrte_iof_hnp_component.dcmp_msgs,
+                             (unsigned long)prrte_iof_hnp_component.dcmp_inbytes,
+                             (unsigned long)prrte_iof_hnp_component.dcmp_outbytes,
+                             100.0 * (double)prrte_iof_hnp_component.dcmp_inbytes /
+                                     (double)prrte_iof_hnp_component.dcmp_outbytes,
+                             (unsigned long)prrte_iof_hnp_component.dcmp_usec);
+    }
 
     return PRRTE_SUCCESS;
 }
 
+/* ask the daemon(s) hosting the specified proc(s) for the output
+ * they held back - it arrives like any other forwarded output unless
+ * it was requested for a specific requestor. Our own local procs
+ * never have output held back */
+static int hnp_tail(const prrte_process_name_t* peer,
+                    const prrte_process_name_t* requestor)
+{
+    prrte_process_name_t host, target;
+    prrte_proc_t *proc;
+
+    target = *peer;
+    if (PRRTE_VPID_WILDCARD == peer->vpid) {
+        host.jobid = PRRTE_PROC_MY_NAME->jobid;
+        host.vpid = PRRTE_VPID_WILDCARD;
+    } else {
+        if (NULL == (proc = prrte_get_proc_object(&target)) ||
+            NULL == proc->node || NULL == proc->node->daemon) {
+            return PRRTE_ERR_NOT_FOUND;
+        }
+        host = proc->node->daemon->name;
+        if (PRRTE_EQUAL == prrte_util_compare_name_fields(PRRTE_NS_CMP_ALL, &host, PRRTE_PROC_MY_NAME)) {
+            return PRRTE_SUCCESS;
+        }
+    }
+    return prrte_iof_hnp_send_tail_request(&host, &target, requestor);
+}
+
+/* our stdout/stderr can't keep up - have the daemons stop reading
+ * the output of their procs, and stop reading our own, until it
+ * catches up. The procs then block on their full pipes */
+static void hnp_xonxoff(bool xoff)
+{
+    prrte_process_name_t host, target;
+    prrte_iof_proc_t *proct;
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s iof:hnp sending %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         xoff ? "xoff" : "xon"));
+
+    prrte_iof_hnp_component.xoff = xoff;
+
+    host.jobid = PRRTE_PROC_MY_NAME->jobid;
+    host.vpid = PRRTE_VPID_WILDCARD;
+    target.jobid = PRRTE_JOBID_WILDCARD;
+    target.vpid = PRRTE_VPID_WILDCARD;
+    (void)prrte_iof_hnp_send_data_to_endpoint(&host, &target, xoff ? PRRTE_IOF_XOFF : PRRTE_IOF_XON,
+                                              NULL, 0);
+
+    if (xoff) {
+        /* our read events stop themselves the next time they fire */
+        return;
+    }
+    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
+        if (NULL != proct->revstdout && !proct->revstdout->active) {
+            PRRTE_IOF_READ_ACTIVATE(proct->revstdout);
+        }
+        if (NULL != proct->revstderr && !proct->revstderr->active) {
+            PRRTE_IOF_READ_ACTIVATE(proct->revstderr);
+        }
+    }
+}
+
 int hnp_ft_event(int state) {
     /*
      * Replica doesn't need to do anything for a checkpoint
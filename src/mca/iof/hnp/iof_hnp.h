@@ -64,8 +64,16 @@ BEGIN_C_DECLS
 struct prrte_iof_hnp_component_t {
     prrte_iof_base_component_t super;
     prrte_list_t procs;
+    prrte_proc_table_t proc_table;
     prrte_iof_read_event_t *stdinev;
     prrte_event_t stdinsig;
+    /* our output sinks are backed up - hold off reading output */
+    bool xoff;
+    /* expansion of compressed output batches from the daemons */
+    uint64_t dcmp_msgs;
+    uint64_t dcmp_inbytes;
+    uint64_t dcmp_outbytes;
+    uint64_t dcmp_usec;
 };
 typedef struct prrte_iof_hnp_component_t prrte_iof_hnp_component_t;
 
@@ -76,6 +84,10 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
                        prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                        void* cbdata);
 
+void prrte_iof_hnp_recv_xcast(int status, prrte_process_name_t* sender,
+                             prrte_buffer_t* buffer, prrte_rml_tag_t tag,
+                             void* cbdata);
+
 void prrte_iof_hnp_read_local_handler(int fd, short event, void *cbdata);
 void prrte_iof_hnp_stdin_cb(int fd, short event, void *cbdata);
 bool prrte_iof_hnp_stdin_check(int fd);
@@ -84,6 +96,9 @@ int prrte_iof_hnp_send_data_to_endpoint(prrte_process_name_t *host,
                                        prrte_process_name_t *target,
                                        prrte_iof_tag_t tag,
                                        unsigned char *data, int numbytes);
+int prrte_iof_hnp_send_tail_request(prrte_process_name_t *host,
+                                    prrte_process_name_t *target,
+                                    const prrte_process_name_t *requestor);
 
 END_C_DECLS
 
@@ -183,7 +183,7 @@ void prrte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
              * closing the output stream
              */
             if (NULL != proct->stdinev->wev) {
-                if (PRRTE_IOF_MAX_INPUT_BUFFERS < prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, proct->stdinev->wev)) {
+                if (PRRTE_IOF_MAX_INPUT_BUFFERS < prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, proct->stdinev->wev)) {
                     /* getting too backed up - stop the read event for now if it is still active */
 
                     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
@@ -340,24 +340,31 @@ void prrte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
             if (!exclusive) {
                 /* output this to our local output */
                 if (PRRTE_IOF_STDOUT & rev->tag || prrte_xml_output) {
-                    prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
+                    prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
                 } else {
-                    prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
+                    prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
                 }
             }
         } else {
             /* output this to our local output */
             if (PRRTE_IOF_STDOUT & rev->tag || prrte_xml_output) {
-                prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
+                prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
             } else {
-                prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
+                prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
             }
         }
     }
     /* see if the user wanted the output directed to files */
     if (NULL != rev->sink && !(PRRTE_IOF_STDIN & rev->sink->tag)) {
         /* output to the corresponding file */
-        prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, rev->sink->wev);
+        prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, rev->sink->wev);
+    }
+
+    if (prrte_iof_hnp_component.xoff) {
+        /* our output is backed up - leave the rest in the
+         * pipe until the xon restarts us */
+        rev->active = false;
+        return;
     }
 
     /* re-add the event */
@@ -31,6 +31,9 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif  /* HAVE_SYS_TIME_H */
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #else
@@ -44,6 +47,7 @@
 
 #include "src/mca/rml/rml.h"
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/prtecompress/prtecompress.h"
 #include "src/util/name_fns.h"
 #include "src/threads/threads.h"
 #include "src/runtime/prrte_globals.h"
@@ -67,20 +71,27 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
                        void* cbdata)
 {
     prrte_process_name_t origin, requestor;
-    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
+    unsigned char data[PRRTE_IOF_BASE_READ_MAX];
     prrte_iof_tag_t stream;
     int32_t count, numbytes;
     prrte_iof_sink_t *sink, *next;
     int rc;
     bool exclusive;
     prrte_iof_proc_t *proct;
+    prrte_iof_write_event_t *wev;
     prrte_ns_cmp_bitmask_t mask=PRRTE_NS_CMP_ALL | PRRTE_NS_CMP_WILD;
+    prrte_buffer_t cbuf;
+    uint8_t *packed_data, *cmpdata;
+    size_t inlen, cmplen;
+    struct timeval start, stop;
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                          "%s received IOF from proc %s",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                          PRRTE_NAME_PRINT(sender)));
 
+    PRRTE_CONSTRUCT(&cbuf, prrte_buffer_t);
+
     /* unpack the stream first as this may be flow control info */
     count = 1;
     if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &stream, &count, PRRTE_IOF_TAG))) {
@@ -88,6 +99,48 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
         goto CLEAN_RETURN;
     }
 
+    if (PRRTE_IOF_COMPRESSED & stream) {
+        /* a daemon compressed a batch of output records - expand
+         * it and process the records as if they came directly */
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &inlen, &count, PRRTE_SIZE))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &cmplen, &count, PRRTE_SIZE))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        packed_data = (uint8_t*)malloc(cmplen);
+        count = cmplen;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, packed_data, &count, PRRTE_UINT8))) {
+            PRRTE_ERROR_LOG(rc);
+            free(packed_data);
+            goto CLEAN_RETURN;
+        }
+        gettimeofday(&start, NULL);
+        if (!prrte_compress.decompress_block(&cmpdata, inlen, packed_data, cmplen)) {
+            PRRTE_ERROR_LOG(PRRTE_ERR_UNPACK_FAILURE);
+            free(packed_data);
+            goto CLEAN_RETURN;
+        }
+        gettimeofday(&stop, NULL);
+        free(packed_data);
+        prrte_iof_hnp_component.dcmp_msgs++;
+        prrte_iof_hnp_component.dcmp_inbytes += cmplen;
+        prrte_iof_hnp_component.dcmp_outbytes += inlen;
+        prrte_iof_hnp_component.dcmp_usec += (stop.tv_sec - start.tv_sec) * 1000000 +
+                                             (stop.tv_usec - start.tv_usec);
+        prrte_dss.load(&cbuf, cmpdata, inlen);
+        buffer = &cbuf;
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &stream, &count, PRRTE_IOF_TAG))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+    }
+
     if (PRRTE_IOF_XON & stream) {
         /* re-start the stdin read event */
         if (NULL != prrte_iof_hnp_component.stdinev &&
@@ -118,6 +171,25 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                          PRRTE_NAME_PRINT(&origin)));
 
+    /* a tool wants to see the output the daemons held back */
+    if (PRRTE_IOF_TAIL == stream) {
+        /* get name of the process wishing to receive it */
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &requestor, &count, PRRTE_NAME))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                             "%s received tail cmd from remote tool %s for proc %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             PRRTE_NAME_PRINT(&requestor),
+                             PRRTE_NAME_PRINT(&origin)));
+        if (PRRTE_SUCCESS != (rc = prrte_iof_hnp_module.tail(&origin, &requestor))) {
+            PRRTE_ERROR_LOG(rc);
+        }
+        goto CLEAN_RETURN;
+    }
+
     /* check to see if a tool has requested something */
     if (PRRTE_IOF_PULL & stream) {
         /* get name of the process wishing to be the sink */
@@ -139,19 +211,13 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
             exclusive = false;
         }
         /* do we already have this process in our list? */
-        PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-            if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, &origin)) {
-                /* found it */
-                goto PROCESS;
-            }
+        proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, &origin, true);
+        if (NULL == proct) {
+            /* if we get here, then we don't yet have this proc in our list */
+            proct = prrte_iof_base_add_proc(&prrte_iof_hnp_component.procs,
+                                            &prrte_iof_hnp_component.proc_table, &origin);
         }
-        /* if we get here, then we don't yet have this proc in our list */
-        proct = PRRTE_NEW(prrte_iof_proc_t);
-        proct->name.jobid = origin.jobid;
-        proct->name.vpid = origin.vpid;
-        prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
 
-      PROCESS:
         /* a tool is requesting that we send it a copy of the specified stream(s)
          * from the specified process(es), so create a sink for it
          */
@@ -218,8 +284,19 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
         goto CLEAN_RETURN;
     }
 
-    /* this must have come from a daemon forwarding output - unpack the data */
-    numbytes=PRRTE_IOF_BASE_MSG_MAX;
+    /* this must have come from a daemon forwarding output - daemons
+     * coalesce the output of their local procs, so the message holds
+     * a sequence of (stream, name, data) records. Held-back output
+     * that a tool asked for also names the tool after the proc */
+  RECORD:
+    if (PRRTE_IOF_TAIL & stream) {
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &requestor, &count, PRRTE_NAME))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+    }
+    numbytes=PRRTE_IOF_BASE_READ_MAX;
     if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &numbytes, PRRTE_BYTE))) {
         PRRTE_ERROR_LOG(rc);
         goto CLEAN_RETURN;
@@ -232,19 +309,13 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
                          PRRTE_NAME_PRINT(&origin)));
 
     /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, &origin)) {
-            /* found it */
-            goto NSTEP;
-        }
+    proct = prrte_iof_base_find_proc(&prrte_iof_hnp_component.proc_table, &origin, true);
+    if (NULL == proct) {
+        /* if we get here, then we don't yet have this proc in our list */
+        proct = prrte_iof_base_add_proc(&prrte_iof_hnp_component.procs,
+                                        &prrte_iof_hnp_component.proc_table, &origin);
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = origin.jobid;
-    proct->name.vpid = origin.vpid;
-    prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
 
-  NSTEP:
     /* cycle through the endpoints to see if someone else wants a copy */
     exclusive = false;
     if (NULL != proct->subscribers) {
@@ -253,6 +324,11 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
             if (PRRTE_JOBID_INVALID == sink->daemon.jobid) {
                 continue;
             }
+            /* held-back output only goes to the tool that asked for it */
+            if ((PRRTE_IOF_TAIL & stream) &&
+                PRRTE_EQUAL != prrte_util_compare_name_fields(PRRTE_NS_CMP_ALL, &sink->daemon, &requestor)) {
+                continue;
+            }
             if ((stream & sink->tag) &&
                 sink->name.jobid == origin.jobid &&
                 (PRRTE_VPID_WILDCARD == sink->name.vpid ||
@@ -306,19 +382,95 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
         }
     }
     /* if the user doesn't want a copy written to the screen, then we are done */
-    if (!proct->copy) {
-        return;
+    if (!proct->copy || (PRRTE_IOF_TAIL & stream)) {
+        goto NEXT;
     }
 
     /* output this to our local output unless one of the sinks was exclusive */
     if (!exclusive) {
         if (PRRTE_IOF_STDOUT & stream || prrte_xml_output) {
-            prrte_iof_base_write_output(&origin, stream, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
+            wev = prrte_iof_base.iof_write_stdout->wev;
         } else {
-            prrte_iof_base_write_output(&origin, stream, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
+            wev = prrte_iof_base.iof_write_stderr->wev;
+        }
+        /* the record's cached output tags are only good
+         * if it is the origin's own record */
+        if (PRRTE_EQUAL == prrte_util_compare_name_fields(PRRTE_NS_CMP_ALL, &proct->name, &origin)) {
+            prrte_iof_base_write_proc_output(proct, stream, data, numbytes, wev);
+        } else {
+            prrte_iof_base_write_output(&origin, stream, data, numbytes, wev);
         }
     }
 
+  NEXT:
+    /* move on to the next record, if any */
+    count = 1;
+    rc = prrte_dss.unpack(buffer, &stream, &count, PRRTE_IOF_TAG);
+    if (PRRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
+        goto CLEAN_RETURN;
+    } else if (PRRTE_SUCCESS != rc) {
+        PRRTE_ERROR_LOG(rc);
+        goto CLEAN_RETURN;
+    }
+    count = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &origin, &count, PRRTE_NAME))) {
+        PRRTE_ERROR_LOG(rc);
+        goto CLEAN_RETURN;
+    }
+    goto RECORD;
+
  CLEAN_RETURN:
+    PRRTE_DESTRUCT(&cbuf);
     return;
 }
+
+/* we are one of the daemons, so anything xcast to them
+ * comes to us as well - the only thing we need to act on
+ * is stdin destined for our own local procs */
+void prrte_iof_hnp_recv_xcast(int status, prrte_process_name_t* sender,
+                             prrte_buffer_t* buffer, prrte_rml_tag_t tag,
+                             void* cbdata)
+{
+    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
+    prrte_iof_tag_t stream;
+    int32_t count, numbytes;
+    prrte_process_name_t target;
+    prrte_iof_proc_t *proct;
+    int rc;
+
+    count = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &stream, &count, PRRTE_IOF_TAG))) {
+        PRRTE_ERROR_LOG(rc);
+        return;
+    }
+    if (PRRTE_IOF_STDIN != stream) {
+        return;
+    }
+
+    count = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &target, &count, PRRTE_NAME))) {
+        PRRTE_ERROR_LOG(rc);
+        return;
+    }
+    numbytes = PRRTE_IOF_BASE_MSG_MAX;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &numbytes, PRRTE_BYTE))) {
+        PRRTE_ERROR_LOG(rc);
+        return;
+    }
+
+    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
+        if (target.jobid != proct->name.jobid || NULL == proct->stdinev ||
+            NULL == proct->stdinev->wev ||
+            PRRTE_EQUAL != prrte_util_compare_name_fields(PRRTE_NS_CMP_ALL, PRRTE_PROC_MY_NAME,
+                                                          &proct->stdinev->daemon)) {
+            continue;
+        }
+        PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                             "%s writing %d bytes of stdin to local proc %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), numbytes,
+                             PRRTE_NAME_PRINT(&proct->name)));
+        /* we even send 0 byte events down the pipe so it forces
+         * out any preceding data before closing the stream */
+        prrte_iof_base_write_output(&proct->name, PRRTE_IOF_STDIN, data, numbytes, proct->stdinev->wev);
+    }
+}
@@ -43,6 +43,8 @@
 
 #include "iof_hnp.h"
 
+static int send_to_host(prrte_process_name_t *host, prrte_buffer_t *buf);
+
 int prrte_iof_hnp_send_data_to_endpoint(prrte_process_name_t *host,
                                        prrte_process_name_t *target,
                                        prrte_iof_tag_t tag,
@@ -50,7 +52,6 @@ int prrte_iof_hnp_send_data_to_endpoint(prrte_process_name_t *host,
 {
     prrte_buffer_t *buf;
     int rc;
-    prrte_grpcomm_signature_t *sig;
 
     /* if the host is a daemon and we are in the process of aborting,
      * then ignore this request. We leave it alone if the host is not
@@ -92,6 +93,37 @@ int prrte_iof_hnp_send_data_to_endpoint(prrte_process_name_t *host,
         }
     }
 
+    return send_to_host(host, buf);
+}
+
+/* ask the host daemon(s) to forward the output they held back for
+ * the target - if a requestor is given, the records are marked for
+ * delivery to that requestor alone */
+int prrte_iof_hnp_send_tail_request(prrte_process_name_t *host,
+                                    prrte_process_name_t *target,
+                                    const prrte_process_name_t *requestor)
+{
+    prrte_buffer_t *buf;
+    prrte_iof_tag_t tag = PRRTE_IOF_TAIL;
+    int rc;
+
+    buf = PRRTE_NEW(prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &tag, 1, PRRTE_IOF_TAG)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, target, 1, PRRTE_NAME)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, (NULL == requestor) ? PRRTE_NAME_INVALID : requestor,
+                                              1, PRRTE_NAME))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(buf);
+        return rc;
+    }
+    return send_to_host(host, buf);
+}
+
+static int send_to_host(prrte_process_name_t *host, prrte_buffer_t *buf)
+{
+    prrte_grpcomm_signature_t *sig;
+    int rc;
+
     /* if the target is wildcard, then this needs to go to everyone - xcast it */
     if (PRRTE_PROC_MY_NAME->jobid == host->jobid &&
         PRRTE_VPID_WILDCARD == host->vpid) {
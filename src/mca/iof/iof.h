@@ -197,6 +197,16 @@ typedef int (*prrte_iof_base_output_fn_t)(const prrte_process_name_t* peer,
 typedef int (*prrte_iof_base_push_stdin_fn_t)(const prrte_process_name_t* dst_name,
                                              uint8_t *data, size_t sz);
 
+/**
+ * Deliver the recent output retained for the indicated peer(s)
+ * in place of forwarding it. The provided peer name can include
+ * wildcard values. If a requestor is given, the output goes only
+ * to the sinks that requestor holds - otherwise it is output like
+ * any other forwarded output.
+ */
+typedef int (*prrte_iof_base_tail_fn_t)(const prrte_process_name_t* peer,
+                                        const prrte_process_name_t* requestor);
+
 /* Flag that a job is complete */
 typedef void (*prrte_iof_base_complete_fn_t)(const prrte_job_t *jdata);
 
@@ -221,6 +231,7 @@ struct prrte_iof_base_module_2_0_0_t {
     prrte_iof_base_finalize_fn_t     finalize;
     prrte_iof_base_ft_event_fn_t     ft_event;
     prrte_iof_base_push_stdin_fn_t   push_stdin;
+    prrte_iof_base_tail_fn_t         tail;
 };
 
 typedef struct prrte_iof_base_module_2_0_0_t prrte_iof_base_module_2_0_0_t;
@@ -42,11 +42,16 @@ typedef uint16_t prrte_iof_tag_t;
 #define PRRTE_IOF_STDOUTALL  0x000e
 #define PRRTE_IOF_STDALL     0x000f
 #define PRRTE_IOF_EXCLUSIVE  0x0100
+/* the message holds a compressed block of forwarded output records */
+#define PRRTE_IOF_COMPRESSED 0x0800
 
 /* flow control flags */
 #define PRRTE_IOF_XON        0x1000
 #define PRRTE_IOF_XOFF       0x2000
-/* tool requests */
+/* tool requests - on its own, TAIL asks for the output held back
+ * for a proc; combined with a stream, it marks that held-back output
+ * on its way to the requestor named in the record */
+#define PRRTE_IOF_TAIL       0x0400
 #define PRRTE_IOF_PULL       0x4000
 #define PRRTE_IOF_CLOSE      0x8000
 
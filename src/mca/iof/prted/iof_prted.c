@@ -77,6 +77,9 @@ static int prted_output(const prrte_process_name_t* peer,
                         prrte_iof_tag_t source_tag,
                         const char *msg);
 
+static int prted_tail(const prrte_process_name_t* peer,
+                      const prrte_process_name_t* requestor);
+
 static void prted_complete(const prrte_job_t *jdata);
 
 static int finalize(void);
@@ -99,7 +102,8 @@ prrte_iof_base_module_t prrte_iof_prted_module = {
     .output = prted_output,
     .complete = prted_complete,
     .finalize = finalize,
-    .ft_event = prted_ft_event
+    .ft_event = prted_ft_event,
+    .tail = prted_tail
 };
 
 static int init(void)
@@ -114,7 +118,18 @@ static int init(void)
 
     /* setup the local global variables */
     PRRTE_CONSTRUCT(&prrte_iof_prted_component.procs, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_iof_prted_component.proc_table, prrte_proc_table_t);
+    prrte_proc_table_init(&prrte_iof_prted_component.proc_table, 16, 256);
     prrte_iof_prted_component.xoff = false;
+    prrte_iof_prted_component.fwd_xoff = false;
+    prrte_iof_prted_component.fwd = NULL;
+    prrte_iof_prted_component.fwd_pending = false;
+    prrte_iof_prted_component.cmp_msgs = 0;
+    prrte_iof_prted_component.cmp_inbytes = 0;
+    prrte_iof_prted_component.cmp_outbytes = 0;
+    prrte_iof_prted_component.cmp_usec = 0;
+    prrte_event_evtimer_set(prrte_event_base, &prrte_iof_prted_component.fwd_ev,
+                            prrte_iof_prted_fwd_timeout, NULL);
 
     return PRRTE_SUCCESS;
 }
@@ -131,7 +146,6 @@ static int prted_push(const prrte_process_name_t* dst_name,
     prrte_iof_proc_t *proct;
     int rc;
     prrte_job_t *jobdat=NULL;
-    prrte_ns_cmp_bitmask_t mask;
 
    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                          "%s iof:prted pushing fd %d for process %s",
@@ -150,21 +164,13 @@ static int prted_push(const prrte_process_name_t* dst_name,
     }
 
     /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
-        mask = PRRTE_NS_CMP_ALL;
-
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
+    proct = prrte_iof_base_find_proc(&prrte_iof_prted_component.proc_table, dst_name, false);
+    if (NULL == proct) {
+        /* if we get here, then we don't yet have this proc in our list */
+        proct = prrte_iof_base_add_proc(&prrte_iof_prted_component.procs,
+                                        &prrte_iof_prted_component.proc_table, dst_name);
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = dst_name->jobid;
-    proct->name.vpid = dst_name->vpid;
-    prrte_list_append(&prrte_iof_prted_component.procs, &proct->super);
 
-  SETUP:
     /* get the local jobdata for this proc */
     if (NULL == (jobdat = prrte_get_job_data_object(proct->name.jobid))) {
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
@@ -214,7 +220,6 @@ static int prted_pull(const prrte_process_name_t* dst_name,
                       int fd)
 {
     prrte_iof_proc_t *proct;
-    prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
     int flags;
 
     /* this is a local call - only stdin is suppprted */
@@ -239,19 +244,13 @@ static int prted_pull(const prrte_process_name_t* dst_name,
     }
 
     /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
+    proct = prrte_iof_base_find_proc(&prrte_iof_prted_component.proc_table, dst_name, false);
+    if (NULL == proct) {
+        /* if we get here, then we don't yet have this proc in our list */
+        proct = prrte_iof_base_add_proc(&prrte_iof_prted_component.procs,
+                                        &prrte_iof_prted_component.proc_table, dst_name);
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = dst_name->jobid;
-    proct->name.vpid = dst_name->vpid;
-    prrte_list_append(&prrte_iof_prted_component.procs, &proct->super);
 
-  SETUP:
     PRRTE_IOF_SINK_DEFINE(&proct->stdinev, dst_name, fd, PRRTE_IOF_STDIN,
                          stdin_write_handler);
 
@@ -268,41 +267,91 @@ static int prted_close(const prrte_process_name_t* peer,
                        prrte_iof_tag_t source_tag)
 {
     prrte_iof_proc_t* proct;
-    prrte_ns_cmp_bitmask_t mask = PRRTE_NS_CMP_ALL;
-
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, peer)) {
-            if (PRRTE_IOF_STDIN & source_tag) {
-                if (NULL != proct->stdinev) {
-                    PRRTE_RELEASE(proct->stdinev);
-                }
-                proct->stdinev = NULL;
+
+    proct = prrte_iof_base_find_proc(&prrte_iof_prted_component.proc_table, peer, false);
+    if (NULL != proct) {
+        if (PRRTE_IOF_STDIN & source_tag) {
+            if (NULL != proct->stdinev) {
+                PRRTE_RELEASE(proct->stdinev);
             }
-            if ((PRRTE_IOF_STDOUT & source_tag) ||
-                (PRRTE_IOF_STDMERGE & source_tag)) {
-                if (NULL != proct->revstdout) {
-                    prrte_iof_base_static_dump_output(proct->revstdout);
-                    PRRTE_RELEASE(proct->revstdout);
-                }
-                proct->revstdout = NULL;
+            proct->stdinev = NULL;
+        }
+        if ((PRRTE_IOF_STDOUT & source_tag) ||
+            (PRRTE_IOF_STDMERGE & source_tag)) {
+            if (NULL != proct->revstdout) {
+                prrte_iof_base_static_dump_output(proct->revstdout);
+                PRRTE_RELEASE(proct->revstdout);
             }
-            if (PRRTE_IOF_STDERR & source_tag) {
-                if (NULL != proct->revstderr) {
-                    prrte_iof_base_static_dump_output(proct->revstderr);
-                    PRRTE_RELEASE(proct->revstderr);
-                }
-                proct->revstderr = NULL;
+            proct->revstdout = NULL;
+        }
+        if (PRRTE_IOF_STDERR & source_tag) {
+            if (NULL != proct->revstderr) {
+                prrte_iof_base_static_dump_output(proct->revstderr);
+                PRRTE_RELEASE(proct->revstderr);
             }
-            /* if we closed them all, then remove this proc */
-            if (NULL == proct->stdinev &&
-                NULL == proct->revstdout &&
-                NULL == proct->revstderr) {
-                prrte_list_remove_item(&prrte_iof_prted_component.procs, &proct->super);
-                PRRTE_RELEASE(proct);
+            proct->revstderr = NULL;
+        }
+        /* if we closed them all, then remove this proc */
+        if (NULL == proct->stdinev &&
+            NULL == proct->revstdout &&
+            NULL == proct->revstderr) {
+            prrte_iof_base_remove_proc(&prrte_iof_prted_component.procs,
+                                       &prrte_iof_prted_component.proc_table, proct);
+            PRRTE_RELEASE(proct);
+        }
+    }
+
+    return PRRTE_SUCCESS;
+}
+
+static void tail_proc(prrte_iof_proc_t *proct, const prrte_process_name_t *requestor)
+{
+    prrte_proc_t *child;
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s iof:prted sending tail of %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         PRRTE_NAME_PRINT(&proct->name)));
+
+    prrte_iof_prted_send_tail(proct, requestor);
+    /* if the proc is gone but its channels haven't closed, the last
+     * of its output is still on the way - send that along as well.
+     * A tool asking for a look doesn't change where output goes */
+    if (NULL == requestor &&
+        (NULL != proct->revstdout || NULL != proct->revstderr) &&
+        NULL != (child = prrte_get_proc_object(&proct->name)) &&
+        PRRTE_FLAG_TEST(child, PRRTE_PROC_FLAG_WAITPID)) {
+        proct->tail_dump = true;
+    }
+}
+
+/*
+ * Forward the output retained for the specified local proc(s)
+ * to the HNP
+ */
+static int prted_tail(const prrte_process_name_t* peer,
+                      const prrte_process_name_t* requestor)
+{
+    prrte_iof_proc_t *proct;
+
+    if (0 == prrte_iof_prted_component.tail_chunks) {
+        /* nothing was held back */
+        return PRRTE_SUCCESS;
+    }
+
+    if (PRRTE_VPID_WILDCARD != peer->vpid) {
+        proct = prrte_iof_base_find_proc(&prrte_iof_prted_component.proc_table, peer, false);
+        if (NULL != proct) {
+            tail_proc(proct, requestor);
+        }
+    } else {
+        PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
+            if (PRRTE_JOBID_WILDCARD == peer->jobid || peer->jobid == proct->name.jobid) {
+                tail_proc(proct, requestor);
             }
-            break;
         }
     }
+    prrte_iof_prted_flush();
 
     return PRRTE_SUCCESS;
 }
@@ -314,7 +363,8 @@ static void prted_complete(const prrte_job_t *jdata)
     /* cleanout any lingering sinks */
     PRRTE_LIST_FOREACH_SAFE(proct, next, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
         if (jdata->jobid == proct->name.jobid) {
-            prrte_list_remove_item(&prrte_iof_prted_component.procs, &proct->super);
+            prrte_iof_base_remove_proc(&prrte_iof_prted_component.procs,
+                                       &prrte_iof_prted_component.proc_table, proct);
             PRRTE_RELEASE(proct);
         }
     }
@@ -336,6 +386,23 @@ static int finalize(void)
         PRRTE_RELEASE(proct);
     }
     PRRTE_DESTRUCT(&prrte_iof_prted_component.procs);
+    prrte_proc_table_remove_all(&prrte_iof_prted_component.proc_table);
+    PRRTE_DESTRUCT(&prrte_iof_prted_component.proc_table);
+
+    /* send along anything still being held for the HNP */
+    prrte_iof_prted_flush();
+
+    if (0 < prrte_iof_prted_component.cmp_msgs) {
+        prrte_output_verbose(1, prrte_iof_base_framework.framework_output,
+                             "%s iof:prted compressed %lu msgs: %lu bytes -> %lu bytes (%.1f%%) in %lu usec",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             (unsigned long)prrte_iof_prted_component.cmp_msgs,
+                             (unsigned long)prrte_iof_prted_component.cmp_inbytes,
+                             (unsigned long)prrte_iof_prted_component.cmp_outbytes,
+                             100.0 * (double)prrte_iof_prted_component.cmp_outbytes /
+                                     (double)prrte_iof_prted_component.cmp_inbytes,
+                             (unsigned long)prrte_iof_prted_component.cmp_usec);
+    }
 
     /* Cancel the RML receive */
     prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_IOF_PROXY);
@@ -52,10 +52,12 @@
 #include "prrte_config.h"
 
 #include "src/class/prrte_list.h"
+#include "src/class/prrte_hash_table.h"
 
 #include "src/mca/rml/rml_types.h"
 #include "src/dss/dss.h"
 #include "src/mca/iof/iof.h"
+#include "src/mca/iof/base/base.h"
 
 BEGIN_C_DECLS
 
@@ -65,7 +67,26 @@ BEGIN_C_DECLS
 struct prrte_iof_prted_component_t {
     prrte_iof_base_component_t super;
     prrte_list_t procs;
+    prrte_proc_table_t proc_table;
     bool xoff;
+    /* the HNP can't keep up - hold off reading output */
+    bool fwd_xoff;
+    /* output of our local procs being coalesced for the HNP */
+    prrte_buffer_t *fwd;
+    prrte_event_t fwd_ev;
+    bool fwd_pending;
+    int fwd_batch_size;
+    int fwd_batch_window;
+    /* optional compression of forwarded batches */
+    bool fwd_compress;
+    int fwd_compress_threshold;
+    uint64_t cmp_msgs;
+    uint64_t cmp_inbytes;
+    uint64_t cmp_outbytes;
+    uint64_t cmp_usec;
+    /* number of chunks of recent output to retain per proc
+     * instead of forwarding it (0 => forward everything) */
+    int tail_chunks;
 };
 typedef struct prrte_iof_prted_component_t prrte_iof_prted_component_t;
 
@@ -77,6 +98,11 @@ void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
                          void* cbdata);
 
 void prrte_iof_prted_read_handler(int fd, short event, void *data);
+void prrte_iof_prted_flush(void);
+void prrte_iof_prted_fwd_timeout(int fd, short args, void *cbdata);
+void prrte_iof_prted_send_tail(prrte_iof_proc_t *proct,
+                               const prrte_process_name_t *requestor);
+void prrte_iof_prted_xon(void);
 void prrte_iof_prted_send_xonxoff(prrte_iof_tag_t tag);
 
 END_C_DECLS
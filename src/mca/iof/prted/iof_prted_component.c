@@ -34,6 +34,7 @@
 /*
  * Local functions
  */
+static int prrte_iof_prted_register(void);
 static int prrte_iof_prted_open(void);
 static int prrte_iof_prted_close(void);
 static int prrte_iof_prted_query(prrte_mca_base_module_t **module, int *priority);
@@ -56,6 +57,7 @@ prrte_iof_prted_component_t prrte_iof_prted_component = {
                                         PRRTE_RELEASE_VERSION),
 
             /* Component open, close, and query functions */
+            .mca_register_component_params = prrte_iof_prted_register,
             .mca_open_component = prrte_iof_prted_open,
             .mca_close_component = prrte_iof_prted_close,
             .mca_query_component = prrte_iof_prted_query,
@@ -67,6 +69,53 @@ prrte_iof_prted_component_t prrte_iof_prted_component = {
     }
 };
 
+static int prrte_iof_prted_register(void)
+{
+    prrte_mca_base_component_t *c = &prrte_iof_prted_component.super.iof_version;
+
+    prrte_iof_prted_component.fwd_batch_size = 65536;
+    (void) prrte_mca_base_component_var_register(c, "batch_size",
+                                           "Number of bytes of output from local procs to coalesce into a single message to the HNP (0 => send each read as it arrives)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.fwd_batch_size);
+
+    prrte_iof_prted_component.fwd_batch_window = 10000;
+    (void) prrte_mca_base_component_var_register(c, "batch_window",
+                                           "Max time (in microseconds) output from local procs is held while coalescing it for the HNP",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.fwd_batch_window);
+
+    prrte_iof_prted_component.fwd_compress = false;
+    (void) prrte_mca_base_component_var_register(c, "compress",
+                                           "Compress batches of output forwarded to the HNP",
+                                           PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.fwd_compress);
+
+    prrte_iof_prted_component.fwd_compress_threshold = 4096;
+    (void) prrte_mca_base_component_var_register(c, "compress_threshold",
+                                           "Min number of bytes in a batch of forwarded output before it is compressed",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.fwd_compress_threshold);
+
+    prrte_iof_prted_component.tail_chunks = 0;
+    (void) prrte_mca_base_component_var_register(c, "tail",
+                                           "Number of 4KB chunks of the most recent output to retain for each local proc instead of forwarding its output to the HNP - the retained output is delivered when the proc terminates abnormally or a tool asks for it (0 => forward all output)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.tail_chunks);
+
+    return PRRTE_SUCCESS;
+}
+
 /**
   * component open/close/init function
   */
@@ -28,12 +28,16 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif  /* HAVE_SYS_TIME_H */
 
 #include "src/dss/dss.h"
 
 #include "src/mca/rml/rml.h"
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/odls/odls_types.h"
+#include "src/mca/prtecompress/prtecompress.h"
 #include "src/util/name_fns.h"
 #include "src/threads/threads.h"
 #include "src/mca/state/state.h"
@@ -44,12 +48,233 @@
 
 #include "iof_prted.h"
 
+/* replace a batch of records with a single compressed block - the
+ * batch is returned untouched if it cannot be compressed */
+static prrte_buffer_t *prted_compress(prrte_buffer_t *buf)
+{
+    prrte_buffer_t *cbuf;
+    prrte_iof_tag_t tag = PRRTE_IOF_COMPRESSED;
+    uint8_t *cmpdata;
+    size_t cmplen, inlen = buf->bytes_used;
+    struct timeval start, stop;
+    bool ok;
+    int rc;
+
+    gettimeofday(&start, NULL);
+    ok = prrte_compress.compress_block((uint8_t*)buf->base_ptr, inlen, &cmpdata, &cmplen);
+    gettimeofday(&stop, NULL);
+    if (!ok) {
+        return buf;
+    }
+    prrte_iof_prted_component.cmp_usec += (stop.tv_sec - start.tv_sec) * 1000000 +
+                                          (stop.tv_usec - start.tv_usec);
+    if (inlen <= cmplen) {
+        /* didn't buy us anything */
+        free(cmpdata);
+        return buf;
+    }
+
+    cbuf = PRRTE_NEW(prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(cbuf, &tag, 1, PRRTE_IOF_TAG)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(cbuf, &inlen, 1, PRRTE_SIZE)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(cbuf, &cmplen, 1, PRRTE_SIZE)) ||
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(cbuf, cmpdata, cmplen, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        free(cmpdata);
+        PRRTE_RELEASE(cbuf);
+        return buf;
+    }
+    free(cmpdata);
+
+    prrte_iof_prted_component.cmp_msgs++;
+    prrte_iof_prted_component.cmp_inbytes += inlen;
+    prrte_iof_prted_component.cmp_outbytes += cmplen;
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s iof:prted compressed %d bytes to %d",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), (int)inlen, (int)cmplen));
+    PRRTE_RELEASE(buf);
+    return cbuf;
+}
+
+void prrte_iof_prted_flush(void)
+{
+    prrte_buffer_t *buf = prrte_iof_prted_component.fwd;
+
+    if (prrte_iof_prted_component.fwd_pending) {
+        prrte_event_evtimer_del(&prrte_iof_prted_component.fwd_ev);
+        prrte_iof_prted_component.fwd_pending = false;
+    }
+    if (NULL == buf) {
+        return;
+    }
+    prrte_iof_prted_component.fwd = NULL;
+
+    if (prrte_iof_prted_component.fwd_compress &&
+        prrte_iof_prted_component.fwd_compress_threshold <= (int)buf->bytes_used) {
+        buf = prted_compress(buf);
+    }
+
+    /* start non-blocking RML call to forward received data */
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s iof:prted sending %d bytes to HNP",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), (int)buf->bytes_used));
+
+    prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf, PRRTE_RML_TAG_IOF_HNP,
+                            prrte_rml_send_callback, NULL);
+}
+
+void prrte_iof_prted_fwd_timeout(int fd, short args, void *cbdata)
+{
+    prrte_iof_prted_component.fwd_pending = false;
+    prrte_iof_prted_flush();
+}
+
+/* add a record to the output being held for the HNP - each record
+ * carries the stream, the name of the proc that gave us the data,
+ * and the data itself, so the HNP can unpack records until it runs
+ * off the end of the message. Held-back output that a tool asked
+ * for is marked as such and also carries the name of the tool */
+static int prted_fwd(prrte_iof_tag_t tag, prrte_process_name_t *name,
+                     const prrte_process_name_t *requestor,
+                     unsigned char *data, int32_t numbytes)
+{
+    prrte_buffer_t *buf;
+    struct timeval tv;
+    int rc;
+
+    if (NULL == prrte_iof_prted_component.fwd) {
+        prrte_iof_prted_component.fwd = PRRTE_NEW(prrte_buffer_t);
+    }
+    buf = prrte_iof_prted_component.fwd;
+
+    if (NULL != requestor) {
+        tag |= PRRTE_IOF_TAIL;
+    }
+    /* pack the stream first - we do this so that flow control messages can
+     * consist solely of the tag
+     */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &tag, 1, PRRTE_IOF_TAG))) {
+        goto error;
+    }
+    /* pack name of process that gave us this data */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, name, 1, PRRTE_NAME))) {
+        goto error;
+    }
+    if (NULL != requestor &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, requestor, 1, PRRTE_NAME))) {
+        goto error;
+    }
+    /* pack the data - only pack the #bytes we read! */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, data, numbytes, PRRTE_BYTE))) {
+        goto error;
+    }
+
+    /* send it along once enough has accumulated, otherwise
+     * make sure it doesn't sit here for long */
+    if (prrte_iof_prted_component.fwd_batch_size <= (int)buf->bytes_used) {
+        prrte_iof_prted_flush();
+    } else if (!prrte_iof_prted_component.fwd_pending) {
+        tv.tv_sec = prrte_iof_prted_component.fwd_batch_window / 1000000;
+        tv.tv_usec = prrte_iof_prted_component.fwd_batch_window % 1000000;
+        prrte_event_evtimer_add(&prrte_iof_prted_component.fwd_ev, &tv);
+        prrte_iof_prted_component.fwd_pending = true;
+    }
+    return PRRTE_SUCCESS;
+
+  error:
+    /* a partial record would corrupt the whole message */
+    PRRTE_ERROR_LOG(rc);
+    prrte_iof_prted_flush();
+    return rc;
+}
+
+/* retain the output in the proc's tail instead of forwarding it,
+ * topping up the newest chunk before starting another - once the
+ * ring is full, the oldest chunk is dropped */
+static void prted_keep(prrte_iof_proc_t *proct, prrte_iof_tag_t tag,
+                       unsigned char *data, int32_t numbytes)
+{
+    prrte_iof_tail_chunk_t *chunk, *old;
+    int n;
+
+    if (NULL == proct->tail) {
+        proct->tail = PRRTE_NEW(prrte_ring_buffer_t);
+        if (PRRTE_SUCCESS != prrte_ring_buffer_init(proct->tail, prrte_iof_prted_component.tail_chunks)) {
+            PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+            PRRTE_RELEASE(proct->tail);
+            proct->tail = NULL;
+            return;
+        }
+    }
+
+    while (0 < numbytes) {
+        chunk = (prrte_iof_tail_chunk_t*)prrte_ring_buffer_poke(proct->tail, -1);
+        if (NULL == chunk || chunk->tag != tag ||
+            PRRTE_IOF_BASE_MSG_MAX == chunk->numbytes) {
+            chunk = PRRTE_NEW(prrte_iof_tail_chunk_t);
+            chunk->tag = tag;
+            if (NULL != (old = (prrte_iof_tail_chunk_t*)prrte_ring_buffer_push(proct->tail, chunk))) {
+                PRRTE_RELEASE(old);
+            }
+        }
+        n = PRRTE_IOF_BASE_MSG_MAX - chunk->numbytes;
+        if (numbytes < n) {
+            n = numbytes;
+        }
+        memcpy(chunk->data + chunk->numbytes, data, n);
+        chunk->numbytes += n;
+        data += n;
+        numbytes -= n;
+    }
+}
+
+/* forward everything retained for the proc, oldest first. A tool
+ * only gets a copy - the output is still there should the proc
+ * fail later on */
+void prrte_iof_prted_send_tail(prrte_iof_proc_t *proct,
+                               const prrte_process_name_t *requestor)
+{
+    prrte_iof_tail_chunk_t *chunk;
+    int i;
+
+    if (NULL == proct->tail) {
+        return;
+    }
+    if (NULL != requestor) {
+        for (i=0; i < prrte_iof_prted_component.tail_chunks; i++) {
+            if (NULL == (chunk = (prrte_iof_tail_chunk_t*)prrte_ring_buffer_poke(proct->tail, i))) {
+                break;
+            }
+            (void)prted_fwd(chunk->tag, &proct->name, requestor, chunk->data, chunk->numbytes);
+        }
+        return;
+    }
+    while (NULL != (chunk = (prrte_iof_tail_chunk_t*)prrte_ring_buffer_pop(proct->tail))) {
+        (void)prted_fwd(chunk->tag, &proct->name, NULL, chunk->data, chunk->numbytes);
+        PRRTE_RELEASE(chunk);
+    }
+}
+
+/* the HNP has caught up - restart the reads we held off */
+void prrte_iof_prted_xon(void)
+{
+    prrte_iof_proc_t *proct;
+
+    prrte_iof_prted_component.fwd_xoff = false;
+    PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
+        if (NULL != proct->revstdout && !proct->revstdout->active) {
+            PRRTE_IOF_READ_ACTIVATE(proct->revstdout);
+        }
+        if (NULL != proct->revstderr && !proct->revstderr->active) {
+            PRRTE_IOF_READ_ACTIVATE(proct->revstderr);
+        }
+    }
+}
+
 void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
 {
     prrte_iof_read_event_t *rev = (prrte_iof_read_event_t*)cbdata;
-    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
-    prrte_buffer_t *buf=NULL;
-    int rc;
+    unsigned char data[PRRTE_IOF_BASE_READ_MAX];
     int32_t numbytes;
     prrte_iof_proc_t *proct = (prrte_iof_proc_t*)rev->proc;
 
@@ -60,8 +285,8 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
      */
     fd = rev->fd;
 
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
+    /* read up to the current read size */
+    numbytes = read(fd, data, rev->rdsize);
 
     if (NULL == proct) {
         /* nothing we can do */
@@ -92,10 +317,18 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
         goto CLEAN_RETURN;
     }
 
+    /* if the proc is producing output faster than we are taking it,
+     * ask for more next time - and back off again once it slows */
+    if (numbytes == rev->rdsize && rev->rdsize < PRRTE_IOF_BASE_READ_MAX) {
+        rev->rdsize *= 2;
+    } else if (numbytes < rev->rdsize / 4 && PRRTE_IOF_BASE_MSG_MAX < rev->rdsize) {
+        rev->rdsize /= 2;
+    }
+
     /* see if the user wanted the output directed to files */
     if (NULL != rev->sink) {
         /* output to the corresponding file */
-        prrte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, rev->sink->wev);
+        prrte_iof_base_write_proc_output(proct, rev->tag, data, numbytes, rev->sink->wev);
     }
     if (!proct->copy) {
         /* re-add the event */
@@ -103,37 +336,20 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
         return;
     }
 
-    /* prep the buffer */
-    buf = PRRTE_NEW(prrte_buffer_t);
-
-    /* pack the stream first - we do this so that flow control messages can
-     * consist solely of the tag
-     */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rev->tag, 1, PRRTE_IOF_TAG))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-
-    /* pack name of process that gave us this data */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &proct->name, 1, PRRTE_NAME))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-
-    /* pack the data - only pack the #bytes we read! */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &data, numbytes, PRRTE_BYTE))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    if (0 < prrte_iof_prted_component.tail_chunks && !proct->tail_dump) {
+        /* hold onto it in case someone asks for it */
+        prted_keep(proct, rev->tag, data, numbytes);
+    } else {
+        /* add it to the output we are forwarding to the HNP */
+        (void)prted_fwd(rev->tag, &proct->name, NULL, data, numbytes);
+        if (prrte_iof_prted_component.fwd_xoff) {
+            /* the HNP is backed up - leave the rest in the
+             * pipe until it sends the xon */
+            rev->active = false;
+            return;
+        }
     }
 
-    /* start non-blocking RML call to forward received data */
-    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
-                         "%s iof:prted:read handler sending %d bytes to HNP",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), numbytes));
-
-    prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf, PRRTE_RML_TAG_IOF_HNP,
-                            prrte_rml_send_callback, NULL);
-
     /* re-add the event */
     PRRTE_IOF_READ_ACTIVATE(rev);
 
@@ -158,11 +374,11 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
     /* check to see if they are all done */
     if (NULL == proct->revstdout &&
         NULL == proct->revstderr) {
+        /* make sure the HNP has all of their output before
+         * it learns they are done */
+        prrte_iof_prted_flush();
         /* this proc's iof is complete */
         PRRTE_ACTIVATE_PROC_STATE(&proct->name, PRRTE_PROC_STATE_IOF_COMPLETE);
     }
-    if (NULL != buf) {
-        PRRTE_RELEASE(buf);
-    }
     return;
 }
@@ -86,8 +86,36 @@ void prrte_iof_prted_send_xonxoff(prrte_iof_tag_t tag)
  * (a) stdin, which is to be copied to whichever local
  *     procs "pull'd" a copy
  *
- * (b) flow control messages
+ * (b) flow control messages for the output we forward
+ *
+ * (c) requests for the output of local procs held back
+ *     in their tails
  */
+static void prted_stdin(prrte_iof_proc_t *proct, prrte_process_name_t *target,
+                        prrte_iof_tag_t stream, unsigned char *data, int32_t numbytes)
+{
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s writing data to local proc %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         PRRTE_NAME_PRINT(&proct->name)));
+    if (NULL == proct->stdinev) {
+        return;
+    }
+    /* send the bytes down the pipe - we even send 0 byte events
+     * down the pipe so it forces out any preceding data before
+     * closing the output stream
+     */
+    if (PRRTE_IOF_MAX_INPUT_BUFFERS < prrte_iof_base_write_output(target, stream, data, numbytes, proct->stdinev->wev)) {
+        /* getting too backed up - tell the HNP to hold off any more input if we
+         * haven't already told it
+         */
+        if (!prrte_iof_prted_component.xoff) {
+            prrte_iof_prted_component.xoff = true;
+            prrte_iof_prted_send_xonxoff(PRRTE_IOF_XOFF);
+        }
+    }
+}
+
 void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
                          prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                          void* cbdata)
@@ -95,7 +123,7 @@ void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
     unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
     prrte_iof_tag_t stream;
     int32_t count, numbytes;
-    prrte_process_name_t target;
+    prrte_process_name_t target, requestor;
     prrte_iof_proc_t *proct;
     int rc;
 
@@ -106,6 +134,35 @@ void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
         return;
     }
 
+    /* flow control of the output we forward */
+    if (PRRTE_IOF_XOFF & stream) {
+        prrte_iof_prted_component.fwd_xoff = true;
+        return;
+    } else if (PRRTE_IOF_XON & stream) {
+        prrte_iof_prted_xon();
+        return;
+    }
+
+    /* the HNP may be asking for the output we held back */
+    if (PRRTE_IOF_TAIL & stream) {
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &target, &count, PRRTE_NAME))) {
+            PRRTE_ERROR_LOG(rc);
+            return;
+        }
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &requestor, &count, PRRTE_NAME))) {
+            PRRTE_ERROR_LOG(rc);
+            return;
+        }
+        if (PRRTE_JOBID_INVALID == requestor.jobid) {
+            prrte_iof_prted_module.tail(&target, NULL);
+        } else {
+            prrte_iof_prted_module.tail(&target, &requestor);
+        }
+        return;
+    }
+
     /* if this isn't stdin, then we have an error */
     if (PRRTE_IOF_STDIN != stream) {
         PRRTE_ERROR_LOG(PRRTE_ERR_COMM_FAILURE);
@@ -132,34 +189,20 @@ void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), numbytes,
                          PRRTE_NAME_PRINT(&target)));
 
+    /* if this is intended for a specific proc, go straight to it */
+    if (PRRTE_VPID_WILDCARD != target.vpid) {
+        proct = prrte_iof_base_find_proc(&prrte_iof_prted_component.proc_table, &target, false);
+        if (NULL != proct) {
+            prted_stdin(proct, &target, stream, data, numbytes);
+        }
+        return;
+    }
+
     /* cycle through our list of procs */
     PRRTE_LIST_FOREACH(proct, &prrte_iof_prted_component.procs, prrte_iof_proc_t) {
         /* is this intended for this jobid? */
         if (target.jobid == proct->name.jobid) {
-            /* yes - is this intended for all vpids or this vpid? */
-            if (PRRTE_VPID_WILDCARD == target.vpid ||
-                proct->name.vpid == target.vpid) {
-                PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
-                                     "%s writing data to local proc %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     PRRTE_NAME_PRINT(&proct->name)));
-                if (NULL == proct->stdinev) {
-                    continue;
-                }
-                /* send the bytes down the pipe - we even send 0 byte events
-                 * down the pipe so it forces out any preceding data before
-                 * closing the output stream
-                 */
-                if (PRRTE_IOF_MAX_INPUT_BUFFERS < prrte_iof_base_write_output(&target, stream, data, numbytes, proct->stdinev->wev)) {
-                    /* getting too backed up - tell the HNP to hold off any more input if we
-                     * haven't already told it
-                     */
-                    if (!prrte_iof_prted_component.xoff) {
-                        prrte_iof_prted_component.xoff = true;
-                        prrte_iof_prted_send_xonxoff(PRRTE_IOF_XOFF);
-                    }
-                }
-            }
+            prted_stdin(proct, &target, stream, data, numbytes);
         }
     }
 }
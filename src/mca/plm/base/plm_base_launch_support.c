@@ -1108,6 +1108,7 @@ void prrte_plm_base_daemon_callback(int status, prrte_process_name_t* sender,
             alias = prrte_argv_join(atmp, ',');
             prrte_set_attribute(&daemon->node->attributes, PRRTE_NODE_ALIAS, PRRTE_ATTR_LOCAL, alias, PRRTE_STRING);
             free(alias);
+            prrte_node_lookup_invalidate();
         }
         prrte_argv_free(atmp);
 
@@ -38,6 +38,15 @@ static bool decompress_block(uint8_t **outbytes, size_t olen,
     return false;
 }
 
+static bool compress_block_level(uint8_t *inbytes,
+                                 size_t inlen,
+                                 int level,
+                                 uint8_t **outbytes,
+                                 size_t *olen)
+{
+    return false;
+}
+
 prrte_prtecompress_base_module_t prrte_compress = {
     NULL, /* init             */
     NULL, /* finalize         */
@@ -46,7 +55,8 @@ prrte_prtecompress_base_module_t prrte_compress = {
     NULL, /* decompress       */
     NULL,  /* decompress_nb    */
     compress_block,
-    decompress_block
+    decompress_block,
+    compress_block_level
 };
 prrte_prtecompress_base_t prrte_prtecompress_base = {0};
 
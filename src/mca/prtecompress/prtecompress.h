@@ -96,6 +96,18 @@ typedef bool (*prrte_prtecompress_base_module_compress_string_fn_t)(uint8_t *inb
 typedef bool (*prrte_prtecompress_base_module_decompress_string_fn_t)(uint8_t **outbytes, size_t olen,
                                                                  uint8_t *inbytes, size_t len);
 
+/**
+ * Compress a string at the given level, regardless of its size
+ *
+ * Arguments:
+ *   level = 1 (fastest) to 9 (smallest)
+ */
+typedef bool (*prrte_prtecompress_base_module_compress_level_fn_t)(uint8_t *inbytes,
+                                                                size_t inlen,
+                                                                int level,
+                                                                uint8_t **outbytes,
+                                                                size_t *olen);
+
 
 /**
  * Structure for COMPRESS components.
@@ -136,6 +148,7 @@ struct prrte_prtecompress_base_module_1_0_0_t {
     /* COMPRESS STRING */
     prrte_prtecompress_base_module_compress_string_fn_t      compress_block;
     prrte_prtecompress_base_module_decompress_string_fn_t    decompress_block;
+    prrte_prtecompress_base_module_compress_level_fn_t       compress_block_level;
 };
 typedef struct prrte_prtecompress_base_module_1_0_0_t prrte_prtecompress_base_module_1_0_0_t;
 typedef struct prrte_prtecompress_base_module_1_0_0_t prrte_prtecompress_base_module_t;
@@ -54,16 +54,31 @@ bool prrte_prtecompress_zlib_compress_block(uint8_t *inbytes,
                                        size_t inlen,
                                        uint8_t **outbytes,
                                        size_t *olen)
+{
+    if (inlen < prrte_prtecompress_base.prtecompress_limit) {
+        return false;
+    }
+    return prrte_prtecompress_zlib_compress_block_level(inbytes, inlen, Z_BEST_COMPRESSION,
+                                                   outbytes, olen);
+}
+
+bool prrte_prtecompress_zlib_compress_block_level(uint8_t *inbytes,
+                                             size_t inlen,
+                                             int level,
+                                             uint8_t **outbytes,
+                                             size_t *olen)
 {
     z_stream strm;
     size_t len;
     uint8_t *tmp;
 
-    if (inlen < prrte_prtecompress_base.prtecompress_limit) {
-        return false;
+    if (level < Z_BEST_SPEED) {
+        level = Z_BEST_SPEED;
+    } else if (Z_BEST_COMPRESSION < level) {
+        level = Z_BEST_COMPRESSION;
     }
     prrte_output_verbose(2, prrte_prtecompress_base_framework.framework_output,
-                        "COMPRESSING");
+                        "COMPRESSING AT LEVEL %d", level);
 
     /* set default output */
     *outbytes = NULL;
@@ -71,7 +86,7 @@ bool prrte_prtecompress_zlib_compress_block(uint8_t *inbytes,
 
     /* setup the stream */
     memset (&strm, 0, sizeof (strm));
-    deflateInit (&strm, 9);
+    deflateInit (&strm, level);
 
     /* get an upper bound on the required output storage */
     len = deflateBound(&strm, inlen);
@@ -101,6 +116,7 @@ bool prrte_prtecompress_zlib_uncompress_block(uint8_t **outbytes, size_t olen,
 {
     uint8_t *dest;
     z_stream strm;
+    int rc;
 
     /* set the default error answer */
     *outbytes = NULL;
@@ -122,8 +138,15 @@ bool prrte_prtecompress_zlib_uncompress_block(uint8_t **outbytes, size_t olen,
     strm.avail_out = olen;
     strm.next_out = dest;
 
-    if (Z_STREAM_END != inflate (&strm, Z_FINISH)) {
-        prrte_output(0, "\tDECOMPRESS FAILED: %s", strm.msg);
+    /* anything short of the whole stream filling exactly olen
+     * bytes means the data is corrupt or truncated */
+    rc = inflate (&strm, Z_FINISH);
+    if (Z_STREAM_END != rc || strm.total_out != olen) {
+        prrte_output(0, "\tDECOMPRESS FAILED: %s",
+                     (NULL == strm.msg) ? "size mismatch" : strm.msg);
+        inflateEnd (&strm);
+        free(dest);
+        return false;
     }
     inflateEnd (&strm);
     *outbytes = dest;
@@ -52,6 +52,11 @@ extern "C" {
                                            size_t *olen);
     bool prrte_prtecompress_zlib_uncompress_block(uint8_t **outbytes, size_t olen,
                                              uint8_t *inbytes, size_t len);
+    bool prrte_prtecompress_zlib_compress_block_level(uint8_t *inbytes,
+                                                 size_t inlen,
+                                                 int level,
+                                                 uint8_t **outbytes,
+                                                 size_t *olen);
 
 #if defined(c_plusplus) || defined(__cplusplus)
 }
@@ -64,6 +64,9 @@ static prrte_prtecompress_base_module_t loc_module = {
 
     /** Deprtecompress Function */
     .decompress_block = prrte_prtecompress_zlib_uncompress_block,
+
+    /** Compress at a given level */
+    .compress_block_level = prrte_prtecompress_zlib_compress_block_level,
 };
 
 int prrte_prtecompress_zlib_component_query(prrte_mca_base_module_t **module, int *priority)
@@ -240,5 +240,8 @@ int prrte_ras_base_node_insert(prrte_list_t* nodes, prrte_job_t *jdata)
         }
     }
 
+    /* names and aliases of existing nodes may have changed */
+    prrte_node_lookup_invalidate();
+
     return PRRTE_SUCCESS;
 }
@@ -133,6 +133,43 @@ int prrte_rmaps_base_filter_nodes(prrte_app_context_t *app,
 }
 
 
+/* check if a node in the pool can be considered for this mapping */
+static bool node_is_usable(prrte_node_t *node, bool novm)
+{
+    /* ignore nodes that are non-usable */
+    if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
+        return false;
+    }
+    /* ignore nodes that are marked as do-not-use for this mapping */
+    if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_USE", node->name));
+        /* reset the state so it can be used another time */
+        node->state = PRRTE_NODE_STATE_UP;
+        return false;
+    }
+    if (PRRTE_NODE_STATE_DOWN == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED DOWN", node->name));
+        return false;
+    }
+    if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_INCLUDE", node->name));
+        /* not to be used */
+        return false;
+    }
+    /* if this node wasn't included in the vm (e.g., by -host), ignore it,
+     * unless we are mapping prior to launching the vm
+     */
+    if (NULL == node->daemon && !novm) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s HAS NO DAEMON", node->name));
+        return false;
+    }
+    return true;
+}
+
 /*
  * Query the registry for all nodes allocated to a specified app_context
  */
@@ -218,47 +255,13 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
          * in the node_pool.
          */
         PRRTE_LIST_FOREACH_SAFE(nptr, next, &nodes, prrte_node_t) {
-            for (i=0; i < prrte_node_pool->size; i++) {
-                if (NULL == (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
-                    continue;
-                }
-                /* ignore nodes that are non-usable */
-                if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
-                    continue;
-                }
-                /* ignore nodes that are marked as do-not-use for this mapping */
-                if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_USE", node->name));
-                    /* reset the state so it can be used another time */
-                    node->state = PRRTE_NODE_STATE_UP;
-                    continue;
-                }
-                if (PRRTE_NODE_STATE_DOWN == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS DOWN", node->name));
-                    continue;
-                }
-                if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_INCLUDE", node->name));
-                    /* not to be used */
-                    continue;
-                }
-                /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-                 * unless we are mapping prior to launching the vm
-                 */
-                if (NULL == node->daemon && !novm) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s HAS NO DAEMON", node->name));
-                    continue;
-                }
-                if (!prrte_node_match(node, nptr->name)) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s DOESNT MATCH NODE %s",
-                                         node->name, nptr->name));
-                    continue;
-                }
+            /* use the hashed index of names and aliases instead
+             * of searching the entire node pool for each entry */
+            node = prrte_node_lookup(nptr->name);
+            if (NULL == node) {
+                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                                     "NODE %s NOT FOUND IN POOL", nptr->name));
+            } else if (node_is_usable(node, novm)) {
                 /* retain a copy for our use in case the item gets
                  * destructed along the way
                  */
@@ -273,7 +276,6 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
                 /* the list is ordered as per user direction using -host
                  * or the listing in -hostfile - preserve that ordering */
                 prrte_list_append(allocated_nodes, &node->super);
-                break;
             }
             /* remove the item from the list as we have allocated it */
             prrte_list_remove_item(&nodes, (prrte_list_item_t*)nptr);
@@ -305,35 +307,7 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
     }
     for (i=1; i < prrte_node_pool->size; i++) {
         if (NULL != (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
-            /* ignore nodes that are non-usable */
-            if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
-                continue;
-            }
-            /* ignore nodes that are marked as do-not-use for this mapping */
-            if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED NO_USE", node->name));
-                /* reset the state so it can be used another time */
-                node->state = PRRTE_NODE_STATE_UP;
-                continue;
-            }
-            if (PRRTE_NODE_STATE_DOWN == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED DOWN", node->name));
-                continue;
-            }
-            if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED NO_INCLUDE", node->name));
-                /* not to be used */
-                continue;
-            }
-            /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-             * unless we are mapping prior to launching the vm
-             */
-            if (NULL == node->daemon && !novm) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s HAS NO DAEMON", node->name));
+            if (!node_is_usable(node, novm)) {
                 continue;
             }
             /* retain a copy for our use in case the item gets
@@ -183,6 +183,9 @@ BEGIN_C_DECLS
 /* pmix log requests */
 #define PRRTE_RML_TAG_LOGGING                65
 
+/* blocks of group context ids */
+#define PRRTE_RML_TAG_CONTEXT_ID             66
+
 #define PRRTE_RML_TAG_MAX                   100
 
 
@@ -337,9 +337,15 @@ static void set(prrte_job_t *jobdat,
             free(param);
         }
     } else {
-        /* convert the list to a cpuset */
-        cpuset = hwloc_bitmap_alloc();
-        if (0 != (rc = hwloc_bitmap_list_sscanf(cpuset, cpu_bitmap))) {
+        /* convert the list to a cpuset - reuse the parse if the
+         * topology has already seen this bitmap */
+        if (NULL != (cpuset = prrte_hwloc_base_get_cpuset(prrte_hwloc_topology, cpu_bitmap))) {
+            rc = 0;
+        } else {
+            cpuset = hwloc_bitmap_alloc();
+            rc = hwloc_bitmap_list_sscanf(cpuset, cpu_bitmap);
+        }
+        if (0 != rc) {
             /* See comment above about "This may be a small memory leak" */
             prrte_asprintf(&msg, "hwloc_bitmap_sscanf returned \"%s\" for the string \"%s\"",
                      prrte_strerror(rc), cpu_bitmap);
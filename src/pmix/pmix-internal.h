@@ -430,6 +430,14 @@ typedef struct {
     } while(0);
 
 #define PRRTE_PMIX_SHOW_HELP    "prrte.show.help"
+/* qualifier on a proc table query asking for only the entries
+ * that changed since the given epoch - the current epoch of the
+ * table is returned under the same key */
+#define PRRTE_PMIX_QUERY_EPOCH  "prrte.query.epoch"
+/* ask for the output the daemons held back for the procs of the
+ * job (or the single proc given by a PMIX_RANK qualifier) to be sent
+ * to the requestor's IOF sinks - it arrives as ordinary output */
+#define PRRTE_PMIX_QUERY_IOF_TAIL   "prrte.query.iof.tail"
 
 /* some helper functions */
 PRRTE_EXPORT pmix_proc_state_t prrte_pmix_convert_state(int state);
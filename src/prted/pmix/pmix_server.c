@@ -85,11 +85,55 @@ static void pmix_server_dmdx_recv(int status, prrte_process_name_t* sender,
 static void pmix_server_dmdx_resp(int status, prrte_process_name_t* sender,
                                   prrte_buffer_t *buffer,
                                   prrte_rml_tag_t tg, void *cbdata);
+static void pmix_server_dmdx_recv_batch(int status, prrte_process_name_t* sender,
+                                        prrte_buffer_t *buffer,
+                                        prrte_rml_tag_t tg, void *cbdata);
+static void pmix_server_dmdx_resp_batch(int status, prrte_process_name_t* sender,
+                                        prrte_buffer_t *buffer,
+                                        prrte_rml_tag_t tg, void *cbdata);
 static void pmix_server_log(int status, prrte_process_name_t* sender,
                             prrte_buffer_t *buffer,
                             prrte_rml_tag_t tg, void *cbdata);
 
 #define PRRTE_PMIX_SERVER_MIN_ROOMS    4096
+#define PRRTE_PMIX_SERVER_INIT_ROOMS   256
+
+/* direct modex messages being aggregated for a daemon */
+typedef struct {
+    prrte_object_t super;
+    prrte_event_t ev;
+    bool active;
+    prrte_process_name_t dmn;
+    prrte_rml_tag_t tag;
+    int nmsgs;
+    prrte_buffer_t *msg;
+} dmdx_batch_t;
+static void dmdx_timeout(int sd, short args, void *cbdata);
+static void dmdx_flush(dmdx_batch_t *batch);
+static void dbcon(dmdx_batch_t *p)
+{
+    prrte_event_evtimer_set(prrte_event_base, &p->ev, dmdx_timeout, p);
+    p->active = false;
+    p->dmn = *PRRTE_NAME_INVALID;
+    p->tag = 0;
+    p->nmsgs = 0;
+    p->msg = NULL;
+}
+static void dbdes(dmdx_batch_t *p)
+{
+    if (p->active) {
+        prrte_event_evtimer_del(&p->ev);
+    }
+    if (NULL != p->msg) {
+        PRRTE_RELEASE(p->msg);
+    }
+}
+static PRRTE_CLASS_INSTANCE(dmdx_batch_t,
+                            prrte_object_t,
+                            dbcon, dbdes);
+
+/* log records being aggregated for the HNP */
+static dmdx_batch_t *log_batch = NULL;
 
 pmix_server_globals_t prrte_pmix_server_globals = {0};
 
@@ -211,6 +255,59 @@ void pmix_server_register_params(void)
                                   PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
                                   PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prrte_pmix_server_globals.system_server);
+
+    /* whether or not to only register proc-level data for local procs */
+    prrte_pmix_server_globals.compact_registration = false;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_compact_registration",
+                                  "Only register proc-level data for local procs when registering a job - data for "
+                                  "remote procs is obtained from the node and proc maps, or by direct modex",
+                                  PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.compact_registration);
+
+    /* aggregation of direct modex traffic */
+    prrte_pmix_server_globals.dmdx_batch_size = 32;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_dmdx_batch_size",
+                                  "Max number of direct modex requests or responses to aggregate into one message to a daemon (<= 1 sends each one separately)",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.dmdx_batch_size);
+    prrte_pmix_server_globals.dmdx_batch_window = 0;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_dmdx_batch_window",
+                                  "Time (in microseconds) to wait for additional direct modex requests or responses to a daemon before sending a partial batch (default: 0, i.e., only aggregate those generated by the same pass of the event loop)",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.dmdx_batch_window);
+
+    /* whether or not to prefetch the data for a remote node's procs */
+    prrte_pmix_server_globals.dmdx_prefetch = false;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_dmdx_prefetch",
+                                  "Upon a direct modex request for a remote proc, also request the data for all other procs of that job on the same node",
+                                  PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.dmdx_prefetch);
+
+    /* aggregation of log requests forwarded to the HNP */
+    prrte_pmix_server_globals.log_batch_size = 64;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_log_batch_size",
+                                  "Max number of log requests to aggregate into one message to the HNP (<= 1 sends each one separately)",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.log_batch_size);
+    prrte_pmix_server_globals.log_batch_window = 10000;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_log_batch_window",
+                                  "Time (in microseconds) to wait for additional log requests before sending a partial batch to the HNP",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.log_batch_window);
+
+    /* number of context ids a daemon reserves from the HNP at a time */
+    prrte_pmix_server_globals.cid_block = 64;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "server_cid_block_size",
+                                  "Number of group context ids each daemon reserves from the HNP at a time for assignment to groups whose members are all local to it (0 => always obtain the id thru a global collective)",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.cid_block);
 }
 
 static void eviction_cbfunc(struct prrte_hotel_t *hotel,
@@ -270,10 +367,19 @@ static void eviction_cbfunc(struct prrte_hotel_t *hotel,
             return;
         }
         /* fall thru and return an error so the caller doesn't hang */
+    } else if (req->dmdx_prefetch) {
+        /* nobody asked for it, so this isn't worth complaining about */
+        prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                             "%s server:evict prefetch for %s:%u timed out",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             req->tproc.nspace, req->tproc.rank);
     } else {
         prrte_show_help("help-prted.txt", "timedout", true, req->operation);
     }
 
+    /* nor anyone waiting on the data this request was fetching */
+    pmix_server_dmdx_abort(req, PMIX_ERR_TIMEOUT);
+
     /* don't let the caller hang */
     if (0 <= req->remote_room_num) {
         send_error(rc, &req->tproc, &req->proxy, req->remote_room_num);
@@ -292,8 +398,12 @@ static void eviction_cbfunc(struct prrte_hotel_t *hotel,
 /* NOTE: this function must be called from within an event! */
 void prrte_pmix_server_clear(pmix_proc_t *pname)
 {
-    int n;
+    int n, rc;
+    size_t m, nkeys;
     pmix_server_req_t *req;
+    prrte_process_name_t name, cname;
+    prrte_object_t *d;
+    uint64_t ui64, *keys;
 
     for (n=0; n < prrte_pmix_server_globals.reqs.num_rooms; n++) {
         prrte_hotel_knock(&prrte_pmix_server_globals.reqs, n, (void**)&req);
@@ -304,13 +414,58 @@ void prrte_pmix_server_clear(pmix_proc_t *pname)
             }
         }
     }
+
+    PRRTE_PMIX_CONVERT_PROCT(rc, &name, pname);
+    if (PRRTE_SUCCESS != rc) {
+        return;
+    }
+
+    /* drop the job's proc table snapshots - a reply still holding
+     * one keeps it alive until qrel returns it */
+    if (PRRTE_VPID_WILDCARD == name.vpid) {
+        for (n=0; n < 2; n++) {
+            ui64 = ((uint64_t)name.jobid << 1) | (uint64_t)n;
+            if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.proc_tables,
+                                                                 ui64, (void**)&d)) {
+                prrte_hash_table_remove_value_uint64(&prrte_pmix_server_globals.proc_tables, ui64);
+                PRRTE_RELEASE(d);
+            }
+        }
+    }
+
+    /* drop any prefetched data that was never used */
+    if (0 == (nkeys = prrte_hash_table_get_size(&prrte_pmix_server_globals.dmdx_cache))) {
+        return;
+    }
+    keys = (uint64_t*)malloc(nkeys * sizeof(uint64_t));
+    if (NULL == keys) {
+        return;
+    }
+    m = 0;
+    PRRTE_HASH_TABLE_FOREACH(ui64, uint64, d, &prrte_pmix_server_globals.dmdx_cache) {
+        memcpy(&cname, (char*)&ui64, sizeof(uint64_t));
+        if (cname.jobid == name.jobid &&
+            (PRRTE_VPID_WILDCARD == name.vpid || cname.vpid == name.vpid) &&
+            m < nkeys) {
+            keys[m++] = ui64;
+        }
+    }
+    while (0 < m) {
+        --m;
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_cache,
+                                                             keys[m], (void**)&d)) {
+            prrte_hash_table_remove_value_uint64(&prrte_pmix_server_globals.dmdx_cache, keys[m]);
+            PRRTE_RELEASE(d);
+        }
+    }
+    free(keys);
 }
 /*
  * Initialize global variables used w/in the server.
  */
 int pmix_server_init(void)
 {
-    int rc;
+    int rc, nrooms;
     prrte_list_t ilist;
     prrte_value_t *kv;
     pmix_info_t *info;
@@ -334,20 +489,40 @@ int pmix_server_init(void)
      * have in our environment - with the exception of mpirun. If the
      * user specified the size of the hotel, then use that value. Otherwise,
      * set the value to something large to avoid running out of rooms on
-     * large machines */
+     * large machines. The hotel only opens a few rooms to begin with
+     * and adds more up to this limit as the backlog requires */
     if (-1 == prrte_pmix_server_globals.num_rooms) {
         prrte_pmix_server_globals.num_rooms = prrte_process_info.num_procs * 2;
         if (prrte_pmix_server_globals.num_rooms < PRRTE_PMIX_SERVER_MIN_ROOMS) {
             prrte_pmix_server_globals.num_rooms = PRRTE_PMIX_SERVER_MIN_ROOMS;
         }
     }
-    if (PRRTE_SUCCESS != (rc = prrte_hotel_init(&prrte_pmix_server_globals.reqs,
-                                              prrte_pmix_server_globals.num_rooms,
+    nrooms = prrte_pmix_server_globals.num_rooms;
+    if (PRRTE_PMIX_SERVER_INIT_ROOMS < nrooms) {
+        nrooms = PRRTE_PMIX_SERVER_INIT_ROOMS;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_hotel_init(&prrte_pmix_server_globals.reqs, nrooms,
                                               prrte_event_base, prrte_pmix_server_globals.timeout,
                                               PRRTE_ERROR_PRI, eviction_cbfunc))) {
         PRRTE_ERROR_LOG(rc);
         return rc;
     }
+    prrte_hotel_set_max_rooms(&prrte_pmix_server_globals.reqs, prrte_pmix_server_globals.num_rooms);
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.dmdx_reqs, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_pmix_server_globals.dmdx_reqs, nrooms);
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.dmdx_batches, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_pmix_server_globals.dmdx_batches, 128);
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.dmdx_cache, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_pmix_server_globals.dmdx_cache, 128);
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.proc_tables, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_pmix_server_globals.proc_tables, 32);
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.grp_sigs, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_pmix_server_globals.grp_sigs, 128);
+    prrte_pmix_server_globals.cid_next = 0;
+    prrte_pmix_server_globals.cid_last = 0;
+    prrte_pmix_server_globals.cid_requested = false;
+    PRRTE_CONSTRUCT(&prrte_pmix_server_globals.cid_waiting, prrte_pointer_array_t);
+    prrte_pointer_array_init(&prrte_pmix_server_globals.cid_waiting, 1, INT_MAX, 8);
     PRRTE_CONSTRUCT(&prrte_pmix_server_globals.notifications, prrte_list_t);
     prrte_pmix_server_globals.server = *PRRTE_NAME_INVALID;
 
@@ -525,11 +700,11 @@ void pmix_server_start(void)
 
     /* setup recv for direct modex requests */
     prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_DIRECT_MODEX,
-                            PRRTE_RML_PERSISTENT, pmix_server_dmdx_recv, NULL);
+                            PRRTE_RML_PERSISTENT, pmix_server_dmdx_recv_batch, NULL);
 
     /* setup recv for replies to direct modex requests */
     prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            PRRTE_RML_PERSISTENT, pmix_server_dmdx_resp, NULL);
+                            PRRTE_RML_PERSISTENT, pmix_server_dmdx_resp_batch, NULL);
 
     /* setup recv for replies to proxy launch requests */
     prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_LAUNCH_RESP,
@@ -548,10 +723,21 @@ void pmix_server_start(void)
         prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_LOGGING,
                                 PRRTE_RML_PERSISTENT, pmix_server_log, NULL);
     }
+
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    /* setup recv for context id blocks */
+    prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_CONTEXT_ID,
+                            PRRTE_RML_PERSISTENT, pmix_server_cid_recv, NULL);
+#endif
 }
 
 void pmix_server_finalize(void)
 {
+    uint64_t ui64;
+    dmdx_batch_t *batch;
+    prrte_object_t *d;
+    int n;
+
     if (!prrte_pmix_server_globals.initialized) {
         return;
     }
@@ -560,6 +746,13 @@ void pmix_server_finalize(void)
                         "%s Finalizing PMIX server",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
 
+    /* send any log requests we are holding */
+    if (NULL != log_batch) {
+        dmdx_flush(log_batch);
+        PRRTE_RELEASE(log_batch);
+        log_batch = NULL;
+    }
+
     /* stop receives */
     prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_DIRECT_MODEX);
     prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_DIRECT_MODEX_RESP);
@@ -569,6 +762,9 @@ void pmix_server_finalize(void)
     if (PRRTE_PROC_IS_MASTER || PRRTE_PROC_IS_MASTER) {
         prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_LOGGING);
     }
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_CONTEXT_ID);
+#endif
 
     /* finalize our local data server */
     prrte_data_server_finalize();
@@ -578,6 +774,32 @@ void pmix_server_finalize(void)
 
     /* cleanup collectives */
     PRRTE_DESTRUCT(&prrte_pmix_server_globals.reqs);
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.dmdx_reqs);
+    PRRTE_HASH_TABLE_FOREACH(ui64, uint64, batch, &prrte_pmix_server_globals.dmdx_batches) {
+        PRRTE_RELEASE(batch);
+    }
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.dmdx_batches);
+    PRRTE_HASH_TABLE_FOREACH(ui64, uint64, d, &prrte_pmix_server_globals.dmdx_cache) {
+        PRRTE_RELEASE(d);
+    }
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.dmdx_cache);
+    PRRTE_HASH_TABLE_FOREACH(ui64, uint64, d, &prrte_pmix_server_globals.grp_sigs) {
+        PRRTE_RELEASE(d);
+    }
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.grp_sigs);
+    PRRTE_HASH_TABLE_FOREACH(ui64, uint64, d, &prrte_pmix_server_globals.proc_tables) {
+        PRRTE_RELEASE(d);
+    }
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.proc_tables);
+    if (prrte_pmix_server_globals.cid_requested) {
+        prrte_event_evtimer_del(&prrte_pmix_server_globals.cid_timer);
+    }
+    for (n=0; n < prrte_pmix_server_globals.cid_waiting.size; n++) {
+        if (NULL != (d = (prrte_object_t*)prrte_pointer_array_get_item(&prrte_pmix_server_globals.cid_waiting, n))) {
+            PRRTE_RELEASE(d);
+        }
+    }
+    PRRTE_DESTRUCT(&prrte_pmix_server_globals.cid_waiting);
     PRRTE_LIST_DESTRUCT(&prrte_pmix_server_globals.notifications);
     PRRTE_LIST_DESTRUCT(&prrte_pmix_server_globals.psets);
     prrte_pmix_server_globals.initialized = false;
@@ -586,7 +808,6 @@ void pmix_server_finalize(void)
 static void send_error(int status, pmix_proc_t *idreq,
                        prrte_process_name_t *remote, int remote_room)
 {
-    prrte_buffer_t *reply;
     pmix_status_t prc, pstatus;
     pmix_data_buffer_t pbuf;
     char *data=NULL;
@@ -615,13 +836,8 @@ static void send_error(int status, pmix_proc_t *idreq,
     }
 
     /* send the response */
-    reply = PRRTE_NEW(prrte_buffer_t);
     PMIX_DATA_BUFFER_UNLOAD(&pbuf, data, sz);
-    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-    prrte_dss.load(reply, data, sz);
-    prrte_rml.send_buffer_nb(remote, reply,
-                            PRRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prrte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(remote, PRRTE_RML_TAG_DIRECT_MODEX_RESP, data, sz);
 
 error:
     PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
@@ -631,7 +847,6 @@ error:
 static void _mdxresp(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
-    prrte_buffer_t *reply;
     pmix_status_t prc;
     pmix_data_buffer_t pbuf;
     char *data;
@@ -682,12 +897,8 @@ static void _mdxresp(int sd, short args, void *cbdata)
     }
 
     /* send the response */
-    reply = PRRTE_NEW(prrte_buffer_t);
     PMIX_DATA_BUFFER_UNLOAD(&pbuf, data, sz);
-    prrte_dss.load(reply, data, sz);
-    prrte_rml.send_buffer_nb(&req->proxy, reply,
-                            PRRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prrte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(&req->proxy, PRRTE_RML_TAG_DIRECT_MODEX_RESP, data, sz);
 
   error:
     PRRTE_RELEASE(req);
@@ -931,14 +1142,51 @@ static void relcbfunc(void *relcbdata)
     PRRTE_RELEASE(d);
 }
 
+bool pmix_server_dmdx_cached(prrte_process_name_t *target)
+{
+    uint64_t ui64;
+    datacaddy_t *d;
+
+    memcpy(&ui64, (char*)target, sizeof(uint64_t));
+    return (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_cache,
+                                                             ui64, (void**)&d));
+}
+
+bool pmix_server_dmdx_serve_cached(pmix_server_req_t *req)
+{
+    uint64_t ui64;
+    datacaddy_t *d;
+
+    memcpy(&ui64, (char*)&req->target, sizeof(uint64_t));
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_cache,
+                                                         ui64, (void**)&d)) {
+        return false;
+    }
+    prrte_hash_table_remove_value_uint64(&prrte_pmix_server_globals.dmdx_cache, ui64);
+    prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                         "%s dmdx:using prefetched data for %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         PRRTE_NAME_PRINT(&req->target));
+    if (NULL != req->mdxcbfunc) {
+        /* our reference passes to the callback */
+        req->mdxcbfunc(PMIX_SUCCESS, d->data, d->ndata, req->cbdata, relcbfunc, d);
+    } else {
+        PRRTE_RELEASE(d);
+    }
+    return true;
+}
+
 static void pmix_server_dmdx_resp(int status, prrte_process_name_t* sender,
                                   prrte_buffer_t *buffer,
                                   prrte_rml_tag_t tg, void *cbdata)
 {
-    int room_num, rnum;
+    int room_num, rc;
     int32_t cnt;
-    pmix_server_req_t *req;
-    datacaddy_t *d;
+    pmix_server_req_t *req, *r, *chain;
+    prrte_process_name_t name;
+    datacaddy_t *d, *dold;
+    uint64_t ui64;
+    bool served;
     pmix_proc_t myproc, pproc;
     pmix_data_buffer_t pbuf;
     char *data;
@@ -1009,80 +1257,273 @@ static void pmix_server_dmdx_resp(int status, prrte_process_name_t* sender,
     /* check the request out of the tracking hotel */
     prrte_hotel_checkout_and_return_occupant(&prrte_pmix_server_globals.reqs, room_num, (void**)&req);
     /* return the returned data to the requestor */
+    served = false;
     if (NULL != req) {
         if (NULL != req->mdxcbfunc) {
             PRRTE_RETAIN(d);
             req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
+            served = true;
         }
-        PRRTE_RELEASE(req);
     } else {
         prrte_output_verbose(2, prrte_pmix_server_globals.output,
                              "REQ WAS NULL IN ROOM %d", room_num);
     }
 
     /* now see if anyone else was waiting for data from this target */
-    for (rnum=0; rnum < prrte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        prrte_hotel_knock(&prrte_pmix_server_globals.reqs, rnum, (void**)&req);
-        if (NULL == req) {
-            continue;
-        }
-        if (PMIX_CHECK_PROCID(&req->tproc, &pproc)) {
-            if (NULL != req->mdxcbfunc) {
+    PRRTE_PMIX_CONVERT_PROCT(rc, &name, &pproc);
+    if (PRRTE_SUCCESS == rc) {
+        chain = pmix_server_dmdx_detach(&name);
+        while (NULL != (r = chain)) {
+            chain = r->dmdx_next;
+            r->dmdx_next = NULL;
+            if (r == req) {
+                /* already responded above */
+                continue;
+            }
+            if (NULL != r->mdxcbfunc) {
                 PRRTE_RETAIN(d);
-                req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
+                r->mdxcbfunc(pret, d->data, d->ndata, r->cbdata, relcbfunc, d);
+                served = true;
             }
-            prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, rnum);
-            PRRTE_RELEASE(req);
+            prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, r->room_num);
+            PRRTE_RELEASE(r);
         }
     }
+    if (NULL != req) {
+        PRRTE_RELEASE(req);
+    }
+    /* if this was a prefetch that nobody has asked for
+     * yet, then hold the data until they do */
+    if (!served && PMIX_SUCCESS == pret && PRRTE_SUCCESS == rc) {
+        memcpy(&ui64, (char*)&name, sizeof(uint64_t));
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_cache,
+                                                             ui64, (void**)&dold)) {
+            PRRTE_RELEASE(dold);
+        }
+        PRRTE_RETAIN(d);
+        prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.dmdx_cache, ui64, d);
+    }
     PRRTE_RELEASE(d);  // maintain accounting
 }
 
+/* a batch is an ordinary message whose payload is a sequence of byte
+ * objects, each holding one request or response exactly as it
+ * would have been sent on its own */
+static void dmdx_unbatch(prrte_process_name_t* sender,
+                         prrte_buffer_t *buffer, prrte_rml_tag_t tg,
+                         prrte_rml_buffer_callback_fn_t cbfunc)
+{
+    prrte_byte_object_t *bo;
+    prrte_buffer_t msg;
+    int32_t cnt = 1;
+    int rc;
+
+    while (PRRTE_SUCCESS == (rc = prrte_dss.unpack(buffer, &bo, &cnt, PRRTE_BYTE_OBJECT))) {
+        PRRTE_CONSTRUCT(&msg, prrte_buffer_t);
+        prrte_dss.load(&msg, bo->bytes, bo->size);
+        bo->bytes = NULL;
+        free(bo);
+        cbfunc(PRRTE_SUCCESS, sender, &msg, tg, NULL);
+        PRRTE_DESTRUCT(&msg);
+        cnt = 1;
+    }
+    if (PRRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PRRTE_ERROR_LOG(rc);
+    }
+}
+
+static void pmix_server_dmdx_recv_batch(int status, prrte_process_name_t* sender,
+                                        prrte_buffer_t *buffer,
+                                        prrte_rml_tag_t tg, void *cbdata)
+{
+    dmdx_unbatch(sender, buffer, tg, pmix_server_dmdx_recv);
+}
+
+static void pmix_server_dmdx_resp_batch(int status, prrte_process_name_t* sender,
+                                        prrte_buffer_t *buffer,
+                                        prrte_rml_tag_t tg, void *cbdata)
+{
+    dmdx_unbatch(sender, buffer, tg, pmix_server_dmdx_resp);
+}
+
+static void dmdx_flush(dmdx_batch_t *batch)
+{
+    int rc;
+
+    if (batch->active) {
+        prrte_event_evtimer_del(&batch->ev);
+        batch->active = false;
+    }
+    if (NULL == batch->msg) {
+        return;
+    }
+    prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                         "%s sending batch of %d on tag %d to %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         batch->nmsgs, (int)batch->tag, PRRTE_NAME_PRINT(&batch->dmn));
+    if (PRRTE_SUCCESS != (rc = prrte_rml.send_buffer_nb(&batch->dmn, batch->msg, batch->tag,
+                                                      prrte_rml_send_callback, NULL))) {
+        /* the requests will be timed out by the hotel */
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(batch->msg);
+    }
+    batch->msg = NULL;
+    batch->nmsgs = 0;
+}
+
+static void dmdx_timeout(int sd, short args, void *cbdata)
+{
+    dmdx_batch_t *batch = (dmdx_batch_t*)cbdata;
+
+    PRRTE_ACQUIRE_OBJECT(batch);
+    batch->active = false;
+    dmdx_flush(batch);
+}
+
+int pmix_server_dmdx_send(prrte_process_name_t *dmn, prrte_rml_tag_t tag,
+                          char *data, size_t sz)
+{
+    dmdx_batch_t *batch;
+    prrte_byte_object_t bo, *boptr;
+    uint64_t ui64;
+    struct timeval tv;
+    int rc;
+
+    ui64 = ((uint64_t)tag << 32) | dmn->vpid;
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_batches,
+                                                         ui64, (void**)&batch)) {
+        batch = PRRTE_NEW(dmdx_batch_t);
+        batch->dmn = *dmn;
+        batch->tag = tag;
+        prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.dmdx_batches, ui64, batch);
+    }
+    if (NULL == batch->msg) {
+        batch->msg = PRRTE_NEW(prrte_buffer_t);
+    }
+
+    bo.bytes = (uint8_t*)data;
+    bo.size = sz;
+    boptr = &bo;
+    rc = prrte_dss.pack(batch->msg, &boptr, 1, PRRTE_BYTE_OBJECT);
+    free(data);
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    ++batch->nmsgs;
+
+    if (prrte_pmix_server_globals.dmdx_batch_size <= batch->nmsgs) {
+        dmdx_flush(batch);
+    } else if (!batch->active) {
+        /* send whatever we have when the window closes */
+        tv.tv_sec = prrte_pmix_server_globals.dmdx_batch_window / 1000000;
+        tv.tv_usec = prrte_pmix_server_globals.dmdx_batch_window % 1000000;
+        prrte_event_evtimer_add(&batch->ev, &tv);
+        batch->active = true;
+    }
+    return PRRTE_SUCCESS;
+}
+
+int pmix_server_log_send(prrte_buffer_t *rec)
+{
+    struct timeval tv;
+    int rc;
+
+    if (NULL == log_batch) {
+        log_batch = PRRTE_NEW(dmdx_batch_t);
+        log_batch->dmn = *PRRTE_PROC_MY_HNP;
+        log_batch->tag = PRRTE_RML_TAG_LOGGING;
+    }
+    if (NULL == log_batch->msg) {
+        log_batch->msg = PRRTE_NEW(prrte_buffer_t);
+    }
+    /* records are self-describing, so just append it */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.copy_payload(log_batch->msg, rec))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    ++log_batch->nmsgs;
+
+    if (prrte_pmix_server_globals.log_batch_size <= log_batch->nmsgs) {
+        dmdx_flush(log_batch);
+    } else if (!log_batch->active) {
+        /* send whatever we have when the window closes */
+        tv.tv_sec = prrte_pmix_server_globals.log_batch_window / 1000000;
+        tv.tv_usec = prrte_pmix_server_globals.log_batch_window % 1000000;
+        prrte_event_evtimer_add(&log_batch->ev, &tv);
+        log_batch->active = true;
+    }
+    return PRRTE_SUCCESS;
+}
+
+/* each message carries a batch of records, each consisting of
+ * the number of info followed by a blob containing them. All
+ * the records are handed to PMIx_Log in a single call */
 static void pmix_server_log(int status, prrte_process_name_t* sender,
                             prrte_buffer_t *buffer,
                             prrte_rml_tag_t tg, void *cbdata)
 {
     int rc;
     int32_t cnt;
-    size_t n, ninfo;
+    size_t n, m, nrecs = 0, ninfo = 0, *counts = NULL;
     pmix_info_t *info, directives[2];
     pmix_status_t ret;
     pmix_proc_t proc;
-    prrte_byte_object_t *boptr;
+    prrte_byte_object_t **blobs = NULL;
     pmix_data_buffer_t pbkt;
 
     (void)prrte_snprintf_jobid(proc.nspace, PMIX_MAX_NSLEN, sender->jobid);
     proc.rank = sender->vpid;
 
-    /* unpack the number of info */
-    cnt = 1;
-    rc = prrte_dss.unpack(buffer, &ninfo, &cnt, PRRTE_SIZE);
-    if (PRRTE_SUCCESS != rc) {
-        PRRTE_ERROR_LOG(rc);
-        return;
+    /* collect the records */
+    while (1) {
+        counts = (size_t*)realloc(counts, (nrecs+1) * sizeof(size_t));
+        blobs = (prrte_byte_object_t**)realloc(blobs, (nrecs+1) * sizeof(prrte_byte_object_t*));
+        /* unpack the number of info */
+        cnt = 1;
+        rc = prrte_dss.unpack(buffer, &counts[nrecs], &cnt, PRRTE_SIZE);
+        if (PRRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
+            break;
+        }
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        /* unpack the blob */
+        cnt = 1;
+        rc = prrte_dss.unpack(buffer, &blobs[nrecs], &cnt, PRRTE_BYTE_OBJECT);
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        ninfo += counts[nrecs];
+        ++nrecs;
     }
-
-    /* unpack the blob */
-    cnt = 1;
-    rc = prrte_dss.unpack(buffer, &boptr, &cnt, PRRTE_BYTE_OBJECT);
-    if (PRRTE_SUCCESS != rc) {
-        PRRTE_ERROR_LOG(rc);
-        return;
+    if (0 == ninfo) {
+        goto cleanup;
     }
 
     PMIX_INFO_CREATE(info, ninfo);
-    PMIX_DATA_BUFFER_LOAD(&pbkt, boptr->bytes, boptr->size);
-    for (n=0; n < ninfo; n++) {
-        cnt = 1;
-        ret = PMIx_Data_unpack(&proc, &pbkt, (void*)&info[n], &cnt, PMIX_INFO);
+    m = 0;
+    for (n=0; n < nrecs; n++) {
+        PMIX_DATA_BUFFER_LOAD(&pbkt, blobs[n]->bytes, blobs[n]->size);
+        blobs[n]->bytes = NULL;
+        cnt = counts[n];
+        ret = PMIx_Data_unpack(&proc, &pbkt, (void*)&info[m], &cnt, PMIX_INFO);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             PMIX_INFO_FREE(info, ninfo);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-            return;
+            goto cleanup;
         }
+        m += counts[n];
     }
-    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+
+    prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                         "%s logging %lu records with %lu info from %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         (unsigned long)nrecs, (unsigned long)ninfo,
+                         PRRTE_NAME_PRINT(sender));
 
     /* mark that we only want it logged once */
     PMIX_INFO_LOAD(&directives[0], PMIX_LOG_ONCE, NULL, PMIX_BOOL);
@@ -1090,10 +1531,21 @@ static void pmix_server_log(int status, prrte_process_name_t* sender,
      * this back up to us */
     PMIX_INFO_LOAD(&directives[1], "prrte.log.noloop", NULL, PMIX_BOOL);
 
-    /* pass the array down to be logged */
+    /* pass the batch down to be logged */
     PMIx_Log(info, ninfo, directives, 2);
-    PMIX_INFO_FREE(info, ninfo+1);
+    PMIX_INFO_FREE(info, ninfo);
+    PMIX_INFO_DESTRUCT(&directives[0]);
     PMIX_INFO_DESTRUCT(&directives[1]);
+
+  cleanup:
+    for (n=0; n < nrecs; n++) {
+        if (NULL != blobs[n]->bytes) {
+            free(blobs[n]->bytes);
+        }
+        free(blobs[n]);
+    }
+    free(blobs);
+    free(counts);
 }
 
 
@@ -1122,6 +1574,112 @@ PRRTE_CLASS_INSTANCE(prrte_pmix_server_op_caddy_t,
                    prrte_object_t,
                    opcon, NULL);
 
+static void dmdx_untrack(pmix_server_req_t *req)
+{
+    uint64_t ui64;
+    pmix_server_req_t *head, *r;
+
+    req->dmdx_indexed = false;
+    if (!prrte_pmix_server_globals.initialized) {
+        return;
+    }
+    memcpy(&ui64, (char*)&req->target, sizeof(uint64_t));
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_reqs,
+                                                         ui64, (void**)&head) ||
+        NULL == head) {
+        return;
+    }
+    if (head == req) {
+        if (NULL == req->dmdx_next) {
+            prrte_hash_table_remove_value_uint64(&prrte_pmix_server_globals.dmdx_reqs, ui64);
+        } else {
+            prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.dmdx_reqs,
+                                              ui64, req->dmdx_next);
+        }
+    } else {
+        for (r=head; NULL != r->dmdx_next; r = r->dmdx_next) {
+            if (r->dmdx_next == req) {
+                r->dmdx_next = req->dmdx_next;
+                break;
+            }
+        }
+    }
+    req->dmdx_next = NULL;
+}
+
+void pmix_server_dmdx_track(pmix_server_req_t *req)
+{
+    uint64_t ui64;
+    pmix_server_req_t *head;
+
+    memcpy(&ui64, (char*)&req->target, sizeof(uint64_t));
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_reqs,
+                                                         ui64, (void**)&head) &&
+        NULL != head) {
+        /* queue behind the request that is fetching the data */
+        req->dmdx_next = head->dmdx_next;
+        head->dmdx_next = req;
+    } else {
+        req->dmdx_next = NULL;
+        prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.dmdx_reqs, ui64, req);
+    }
+    req->dmdx_indexed = true;
+}
+
+pmix_server_req_t* pmix_server_dmdx_pending(prrte_process_name_t *target)
+{
+    uint64_t ui64;
+    pmix_server_req_t *head;
+
+    memcpy(&ui64, (char*)target, sizeof(uint64_t));
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_reqs,
+                                                         ui64, (void**)&head)) {
+        return NULL;
+    }
+    return head;
+}
+
+pmix_server_req_t* pmix_server_dmdx_detach(prrte_process_name_t *target)
+{
+    uint64_t ui64;
+    pmix_server_req_t *head, *r;
+
+    memcpy(&ui64, (char*)target, sizeof(uint64_t));
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.dmdx_reqs,
+                                                         ui64, (void**)&head) ||
+        NULL == head) {
+        return NULL;
+    }
+    prrte_hash_table_remove_value_uint64(&prrte_pmix_server_globals.dmdx_reqs, ui64);
+    for (r=head; NULL != r; r = r->dmdx_next) {
+        r->dmdx_indexed = false;
+    }
+    return head;
+}
+
+void pmix_server_dmdx_abort(pmix_server_req_t *req, pmix_status_t status)
+{
+    pmix_server_req_t *chain, *r;
+
+    if (!req->dmdx_indexed || req != pmix_server_dmdx_pending(&req->target)) {
+        return;
+    }
+    chain = pmix_server_dmdx_detach(&req->target);
+    while (NULL != (r = chain)) {
+        chain = r->dmdx_next;
+        r->dmdx_next = NULL;
+        if (r == req) {
+            /* the caller is responsible for this one */
+            continue;
+        }
+        if (NULL != r->mdxcbfunc) {
+            r->mdxcbfunc(status, NULL, 0, r->cbdata, NULL, NULL);
+        }
+        prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, r->room_num);
+        PRRTE_RELEASE(r);
+    }
+}
+
 static void rqcon(pmix_server_req_t *p)
 {
     p->operation = NULL;
@@ -1140,6 +1698,9 @@ static void rqcon(pmix_server_req_t *p)
     p->range = PMIX_RANGE_SESSION;
     p->proxy = *PRRTE_NAME_INVALID;
     p->target = *PRRTE_NAME_INVALID;
+    p->dmdx_indexed = false;
+    p->dmdx_next = NULL;
+    p->dmdx_prefetch = false;
     p->jdata = NULL;
     PRRTE_CONSTRUCT(&p->msg, prrte_buffer_t);
     p->timeout = prrte_pmix_server_globals.timeout;
@@ -1153,6 +1714,9 @@ static void rqcon(pmix_server_req_t *p)
 }
 static void rqdes(pmix_server_req_t *p)
 {
+    if (p->dmdx_indexed) {
+        dmdx_untrack(p);
+    }
     if (NULL != p->operation) {
         free(p->operation);
     }
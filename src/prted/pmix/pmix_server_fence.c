@@ -75,10 +75,70 @@ static void pmix_server_release(int status, prrte_buffer_t *buf, void *cbdata)
     PRRTE_RELEASE(cd);
 }
 
+/* see if all participants in the collective are hosted by us */
+bool pmix_server_all_local(prrte_grpcomm_signature_t *sig)
+{
+    size_t i;
+    prrte_job_t *jdata;
+    prrte_proc_t *proc;
+
+    for (i=0; i < sig->sz; i++) {
+        if (NULL == (jdata = prrte_get_job_data_object(sig->signature[i].jobid))) {
+            return false;
+        }
+        if (PRRTE_VPID_WILDCARD == sig->signature[i].vpid) {
+            if (jdata->num_local_procs != jdata->num_procs) {
+                return false;
+            }
+            continue;
+        }
+        proc = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, sig->signature[i].vpid);
+        if (NULL == proc || !PRRTE_FLAG_TEST(proc, PRRTE_PROC_FLAG_LOCAL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _fence(int sd, short args, void *cbdata)
+{
+    prrte_pmix_mdx_caddy_t *cd=(prrte_pmix_mdx_caddy_t*)cbdata;
+    char *data = NULL;
+    int32_t ndata = 0;
+    int rc;
+
+    PRRTE_ACQUIRE_OBJECT(cd);
+
+    /* if everyone is local, then the collective is already
+     * complete - the only contribution is our own, which is
+     * exactly what grpcomm would have returned */
+    if (pmix_server_all_local(cd->sig)) {
+        prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                             "%s fence: all participants local",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
+        prrte_dss.unload(cd->buf, (void**)&data, &ndata);
+        cd->cbfunc(PRRTE_SUCCESS, data, ndata, cd->cbdata, relcb, data);
+        PRRTE_RELEASE(cd);
+        return;
+    }
+
+    /* pass it to the global collective algorithm */
+    /* pass along any data that was collected locally */
+    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.allgather(cd->sig, cd->buf, 0, pmix_server_release, cd))) {
+        PRRTE_ERROR_LOG(rc);
+        cd->cbfunc(prrte_pmix_convert_rc(rc), NULL, 0, cd->cbdata, NULL, NULL);
+        PRRTE_RELEASE(cd);
+        return;
+    }
+    PRRTE_RELEASE(cd->buf);
+    cd->buf = NULL;
+}
+
 /* this function is called when all the local participants have
  * called fence - thus, the collective is already locally
  * complete at this point. We therefore just need to create the
- * signature and pass the collective into grpcomm */
+ * signature and pass the collective into grpcomm, unless all
+ * of the participants are ours */
 pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
                                      const pmix_info_t info[], size_t ninfo,
                                      char *data, size_t ndata,
@@ -120,14 +180,19 @@ pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
         free(tmp);
     }
 
-    /* pass it to the global collective algorithm */
-    /* pass along any data that was collected locally */
-    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.allgather(cd->sig, buf, 0, pmix_server_release, cd))) {
-        PRRTE_ERROR_LOG(rc);
+    /* we cannot look at the job data from the PMIx server's
+     * thread, so shift to ours to see if everyone is local */
+    if (NULL == cd->sig) {
+        if (PRRTE_SUCCESS != (rc = prrte_grpcomm.allgather(cd->sig, buf, 0, pmix_server_release, cd))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_RELEASE(buf);
+            return PMIX_ERROR;
+        }
         PRRTE_RELEASE(buf);
-        return PMIX_ERROR;
+        return PMIX_SUCCESS;
     }
-    PRRTE_RELEASE(buf);
+    cd->buf = buf;
+    PRRTE_THREADSHIFT(cd, prrte_event_base, _fence, PRRTE_MSG_PRI);
     return PMIX_SUCCESS;
 }
 
@@ -136,7 +201,6 @@ static void modex_resp(pmix_status_t status,
                        void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
-    prrte_buffer_t *reply;
     pmix_status_t prc;
     pmix_data_buffer_t pbuf;
     char *pdata;
@@ -178,27 +242,83 @@ static void modex_resp(pmix_status_t status,
     }
 
     /* send the response */
-    reply = PRRTE_NEW(prrte_buffer_t);
     PMIX_DATA_BUFFER_UNLOAD(&pbuf, pdata, psz);
-    prrte_dss.load(reply, pdata, psz);
-    prrte_rml.send_buffer_nb(&req->proxy, reply,
-                            PRRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prrte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(&req->proxy, PRRTE_RML_TAG_DIRECT_MODEX_RESP, pdata, psz);
 
   error:
     PRRTE_RELEASE(req);
     return;
 }
 
+/* the data for the other procs of a job that are hosted by
+ * the same daemon is likely to be wanted shortly, so ask for all
+ * of it now - the requests go out in the same batch as the one
+ * that triggered them */
+static void prefetch_node(prrte_job_t *jdata, prrte_proc_t *proct, prrte_proc_t *dmn)
+{
+    pmix_server_req_t *req;
+    prrte_proc_t *pptr;
+    pmix_data_buffer_t pbuf;
+    pmix_proc_t myproc;
+    pmix_status_t prc;
+    char *data;
+    size_t sz;
+    int n, rc;
+
+    PRRTE_PMIX_CONVERT_NAME(&myproc, PRRTE_PROC_MY_NAME);
+    for (n=0; n < proct->node->procs->size; n++) {
+        if (NULL == (pptr = (prrte_proc_t*)prrte_pointer_array_get_item(proct->node->procs, n))) {
+            continue;
+        }
+        if (pptr == proct || pptr->name.jobid != jdata->jobid) {
+            continue;
+        }
+        /* skip anyone whose data is already here or on its way */
+        if (NULL != pmix_server_dmdx_pending(&pptr->name) ||
+            pmix_server_dmdx_cached(&pptr->name)) {
+            continue;
+        }
+        req = PRRTE_NEW(pmix_server_req_t);
+        prrte_asprintf(&req->operation, "DMDX PREFETCH: %s:%d", __FILE__, __LINE__);
+        PRRTE_PMIX_CONVERT_NAME(&req->tproc, &pptr->name);
+        req->target = pptr->name;
+        req->dmdx_prefetch = true;
+        PRRTE_ADJUST_TIMEOUT(req);
+        if (PRRTE_SUCCESS != (rc = prrte_hotel_checkin(&prrte_pmix_server_globals.reqs, req, &req->room_num))) {
+            /* no room - not an error as nobody is waiting on it */
+            PRRTE_RELEASE(req);
+            return;
+        }
+        pmix_server_dmdx_track(req);
+        PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
+        sz = 0;
+        if (PMIX_SUCCESS != (prc = PMIx_Data_pack(&myproc, &pbuf, &req->tproc, 1, PMIX_PROC)) ||
+            PMIX_SUCCESS != (prc = PMIx_Data_pack(&myproc, &pbuf, &req->room_num, 1, PMIX_INT)) ||
+            PMIX_SUCCESS != (prc = PMIx_Data_pack(&myproc, &pbuf, &sz, 1, PMIX_SIZE))) {
+            PMIX_ERROR_LOG(prc);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+            prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, req->room_num);
+            PRRTE_RELEASE(req);
+            return;
+        }
+        PMIX_DATA_BUFFER_UNLOAD(&pbuf, data, sz);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+        if (PRRTE_SUCCESS != pmix_server_dmdx_send(&dmn->name, PRRTE_RML_TAG_DIRECT_MODEX,
+                                                   data, sz)) {
+            prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, req->room_num);
+            PRRTE_RELEASE(req);
+            return;
+        }
+    }
+}
+
 static void dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
-    pmix_server_req_t *r;
     prrte_job_t *jdata;
     prrte_proc_t *proct, *dmn;
     prrte_process_name_t prtenm;
-    int rc, rnum;
-    prrte_buffer_t *buf;
+    int rc;
     char *data=NULL;
     int32_t sz=0;
     pmix_data_buffer_t pbuf;
@@ -265,26 +385,27 @@ static void dmodex_req(int sd, short args, void *cbdata)
      * amount of time to start the job */
     PRRTE_ADJUST_TIMEOUT(req);
 
+    /* did we already prefetch it? */
+    req->target = prtenm;
+    if (!refresh_cache && pmix_server_dmdx_serve_cached(req)) {
+        PRRTE_RELEASE(req);
+        return;
+    }
+
     /* has anyone already requested data for this target? If so,
      * then the data is already on its way */
-    for (rnum=0; rnum < prrte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        prrte_hotel_knock(&prrte_pmix_server_globals.reqs, rnum, (void**)&r);
-        if (NULL == r) {
-            continue;
-        }
-        if (r->target.jobid == prtenm.jobid &&
-            r->target.vpid == prtenm.vpid) {
-            /* save the request in the hotel until the
-             * data is returned */
-            if (PRRTE_SUCCESS != (rc = prrte_hotel_checkin(&prrte_pmix_server_globals.reqs, req, &req->room_num))) {
-                prrte_show_help("help-orted.txt", "noroom", true, req->operation, prrte_pmix_server_globals.num_rooms);
-                /* can't just return as that would cause the requestor
-                 * to hang, so instead execute the callback */
-                prc = prrte_pmix_convert_rc(rc);
-                goto callback;
-            }
-            return;
+    if (NULL != pmix_server_dmdx_pending(&prtenm)) {
+        /* save the request in the hotel until the
+         * data is returned */
+        if (PRRTE_SUCCESS != (rc = prrte_hotel_checkin(&prrte_pmix_server_globals.reqs, req, &req->room_num))) {
+            prrte_show_help("help-orted.txt", "noroom", true, req->operation, prrte_pmix_server_globals.num_rooms);
+            /* can't just return as that would cause the requestor
+             * to hang, so instead execute the callback */
+            prc = prrte_pmix_convert_rc(rc);
+            goto callback;
         }
+        pmix_server_dmdx_track(req);
+        return;
     }
 
     /* lookup who is hosting this proc */
@@ -349,6 +470,8 @@ static void dmodex_req(int sd, short args, void *cbdata)
         prc = prrte_pmix_convert_rc(rc);
         goto callback;
     }
+    /* anyone else wanting this target's data can now wait for it */
+    pmix_server_dmdx_track(req);
     prrte_output_verbose(2, prrte_pmix_server_globals.output,
                         "%s:%d MY REQ ROOM IS %d FOR KEY %s",
                         __FILE__, __LINE__, req->room_num,
@@ -391,23 +514,24 @@ static void dmodex_req(int sd, short args, void *cbdata)
         }
     }
 
-    /* send it to the host daemon */
-    buf = PRRTE_NEW(prrte_buffer_t);
+    /* send it to the host daemon - this will be aggregated with
+     * any other requests we are sending it */
     PMIX_DATA_BUFFER_UNLOAD(&pbuf, data, sz);
     PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
-    prrte_dss.load(buf, data, sz);
-    if (PRRTE_SUCCESS != (rc = prrte_rml.send_buffer_nb(&dmn->name, buf, PRRTE_RML_TAG_DIRECT_MODEX,
-                                                      prrte_rml_send_callback, NULL))) {
-        PRRTE_ERROR_LOG(rc);
+    if (PRRTE_SUCCESS != (rc = pmix_server_dmdx_send(&dmn->name, PRRTE_RML_TAG_DIRECT_MODEX,
+                                                     data, sz))) {
         prrte_hotel_checkout(&prrte_pmix_server_globals.reqs, req->room_num);
-        PRRTE_RELEASE(buf);
         prc = prrte_pmix_convert_rc(rc);
         goto callback;
     }
+    if (prrte_pmix_server_globals.dmdx_prefetch) {
+        prefetch_node(jdata, proct, dmn);
+    }
     return;
 
   callback:
     /* this section gets executed solely upon an error */
+    pmix_server_dmdx_abort(req, prc);
     if (NULL != req->mdxcbfunc) {
         req->mdxcbfunc(prc, NULL, 0, req->cbdata, NULL, NULL);
     }
@@ -40,6 +40,7 @@
 #include "src/mca/pstat/pstat.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/base/base.h"
 #include "src/mca/iof/iof.h"
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/schizo/schizo.h"
@@ -848,6 +849,17 @@ void pmix_tool_connected_fn(pmix_info_t *info, size_t ninfo,
 static void lgcbfn(int sd, short args, void *cbdata)
 {
     prrte_pmix_server_op_caddy_t *cd = (prrte_pmix_server_op_caddy_t*)cbdata;
+    int rc;
+
+    /* add any record to the batch headed for the HNP */
+    if (NULL != cd->server_object) {
+        rc = pmix_server_log_send((prrte_buffer_t*)cd->server_object);
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            cd->status = prrte_pmix_convert_rc(rc);
+        }
+        PRRTE_RELEASE(cd->server_object);
+    }
 
     if (NULL != cd->cbfunc) {
         cd->cbfunc(cd->status, cd->cbdata);
@@ -861,7 +873,7 @@ void pmix_server_log_fn(const pmix_proc_t *client,
                         pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
     size_t n, cnt;
-    prrte_buffer_t *buf;
+    prrte_buffer_t *buf, *rec = NULL;
     prrte_byte_object_t bo, *boptr;
     int rc = PRRTE_SUCCESS;
     pmix_data_buffer_t pbuf;
@@ -912,28 +924,25 @@ void pmix_server_log_fn(const pmix_proc_t *client,
         }
     }
     if (0 < cnt) {
-        buf = PRRTE_NEW(prrte_buffer_t);
-        prrte_dss.pack(buf, &cnt, 1, PRRTE_SIZE);
+        /* the record is added to the batch for our HNP/MASTER
+         * once we are in our own event base */
+        rec = PRRTE_NEW(prrte_buffer_t);
+        prrte_dss.pack(rec, &cnt, 1, PRRTE_SIZE);
         PMIX_DATA_BUFFER_UNLOAD(&pbuf, pbo.bytes, pbo.size);
         bo.bytes = (uint8_t*)pbo.bytes;
         bo.size = pbo.size;
         boptr = &bo;
-        prrte_dss.pack(buf, &boptr, 1, PRRTE_BYTE_OBJECT);
+        prrte_dss.pack(rec, &boptr, 1, PRRTE_BYTE_OBJECT);
         free(bo.bytes);
-        rc = prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf,
-                                     PRRTE_RML_TAG_LOGGING,
-                                     prrte_rml_send_callback, NULL);
-        if (PRRTE_SUCCESS != rc) {
-            PRRTE_ERROR_LOG(rc);
-            PRRTE_RELEASE(buf);
-        }
+    } else {
+        PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
     }
 
   done:
     /* we cannot directly execute the callback here
      * as it would threadlock - so shift to somewhere
      * safe */
-    PRRTE_PMIX_THREADSHIFT(PRRTE_NAME_WILDCARD, NULL, rc,
+    PRRTE_PMIX_THREADSHIFT(PRRTE_NAME_WILDCARD, rec, rc,
                           NULL, NULL, 0, lgcbfn,
                           cbfunc, cbdata);
 }
@@ -1102,13 +1111,312 @@ static void group_release(int status, prrte_buffer_t *buf, void *cbdata)
     }
 }
 
+/* max number of distinct group memberships whose signature we hold */
+#define PRRTE_PMIX_GRP_SIG_CACHE  256
+
+static int name_cmp(const void *a, const void *b)
+{
+    const prrte_process_name_t *n1 = (const prrte_process_name_t*)a;
+    const prrte_process_name_t *n2 = (const prrte_process_name_t*)b;
+
+    if (n1->jobid != n2->jobid) {
+        return (n1->jobid < n2->jobid) ? -1 : 1;
+    }
+    if (n1->vpid != n2->vpid) {
+        return (n1->vpid < n2->vpid) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* get the signature for a group membership. The members are put
+ * in canonical (sorted) order so every daemon computes the same
+ * signature no matter the order in which the procs were given,
+ * and the result is cached so that repeatedly constructing the
+ * same group doesn't rebuild it each time */
+static prrte_grpcomm_signature_t* group_signature(const pmix_proc_t procs[], size_t nprocs)
+{
+    prrte_grpcomm_signature_t *sig;
+    prrte_process_name_t *names;
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned char *ptr;
+    size_t i, sz;
+    int rc;
+
+    sz = nprocs * sizeof(prrte_process_name_t);
+    names = (prrte_process_name_t*)malloc(sz);
+    for (i=0; i < nprocs; i++) {
+        PRRTE_PMIX_CONVERT_PROCT(rc, &names[i], &procs[i]);
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            free(names);
+            return NULL;
+        }
+    }
+    qsort(names, nprocs, sizeof(prrte_process_name_t), name_cmp);
+
+    /* FNV-1a hash of the sorted membership */
+    ptr = (unsigned char*)names;
+    for (i=0; i < sz; i++) {
+        hash ^= ptr[i];
+        hash *= 1099511628211ULL;
+    }
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.grp_sigs,
+                                                           hash, (void**)&sig)) {
+        if (sig->sz == nprocs && 0 == memcmp(sig->signature, names, sz)) {
+            free(names);
+            PRRTE_RETAIN(sig);
+            return sig;
+        }
+        /* collision - just don't cache this one */
+        sig = PRRTE_NEW(prrte_grpcomm_signature_t);
+        sig->sz = nprocs;
+        sig->signature = names;
+        return sig;
+    }
+
+    sig = PRRTE_NEW(prrte_grpcomm_signature_t);
+    sig->sz = nprocs;
+    sig->signature = names;
+    if (prrte_hash_table_get_size(&prrte_pmix_server_globals.grp_sigs) < PRRTE_PMIX_GRP_SIG_CACHE) {
+        PRRTE_RETAIN(sig);
+        prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.grp_sigs, hash, sig);
+    }
+    return sig;
+}
+
+/* we cannot get a block of context ids, so nobody
+ * waiting on one is going to get it */
+static void cid_fail(int status)
+{
+    prrte_pmix_mdx_caddy_t *cd;
+    int i;
+
+    if (prrte_pmix_server_globals.cid_requested) {
+        prrte_event_evtimer_del(&prrte_pmix_server_globals.cid_timer);
+        prrte_pmix_server_globals.cid_requested = false;
+    }
+    for (i=0; i < prrte_pmix_server_globals.cid_waiting.size; i++) {
+        if (NULL == (cd = (prrte_pmix_mdx_caddy_t*)prrte_pointer_array_get_item(&prrte_pmix_server_globals.cid_waiting, i))) {
+            continue;
+        }
+        prrte_pointer_array_set_item(&prrte_pmix_server_globals.cid_waiting, i, NULL);
+        group_release(status, NULL, cd);
+    }
+}
+
+static void cid_timeout(int sd, short args, void *cbdata)
+{
+    PRRTE_ERROR_LOG(PRRTE_ERR_TIMEOUT);
+    cid_fail(PRRTE_ERR_TIMEOUT);
+}
+
+/* ask the HNP for another block of context ids */
+static void request_cids(void)
+{
+    prrte_buffer_t *buf;
+    struct timeval tv = {0, 0};
+    size_t n;
+    int rc;
+
+    if (prrte_pmix_server_globals.cid_requested) {
+        return;
+    }
+    buf = PRRTE_NEW(prrte_buffer_t);
+    n = prrte_pmix_server_globals.cid_block;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &n, 1, PRRTE_SIZE))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(buf);
+        cid_fail(rc);
+        return;
+    }
+    if (0 > (rc = prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf,
+                                          PRRTE_RML_TAG_CONTEXT_ID,
+                                          prrte_rml_send_callback, NULL))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(buf);
+        cid_fail(rc);
+        return;
+    }
+    prrte_pmix_server_globals.cid_requested = true;
+    /* don't leave anyone hanging if the reply never comes */
+    tv.tv_sec = prrte_pmix_server_globals.timeout;
+    prrte_event_evtimer_set(prrte_event_base, &prrte_pmix_server_globals.cid_timer,
+                            cid_timeout, NULL);
+    prrte_event_evtimer_add(&prrte_pmix_server_globals.cid_timer, &tv);
+}
+
+/* take a context id from our reserved block, asking for the next
+ * block once this one runs low. The HNP owns the global counter
+ * and so assigns directly from it */
+static bool get_cid(size_t *cid)
+{
+    if (PRRTE_PROC_IS_MASTER) {
+        *cid = prrte_grpcomm_base.context_id;
+        ++prrte_grpcomm_base.context_id;
+        return true;
+    }
+    if (prrte_pmix_server_globals.cid_next == prrte_pmix_server_globals.cid_last) {
+        return false;
+    }
+    *cid = prrte_pmix_server_globals.cid_next;
+    ++prrte_pmix_server_globals.cid_next;
+    if ((prrte_pmix_server_globals.cid_last - prrte_pmix_server_globals.cid_next) <=
+        (size_t)prrte_pmix_server_globals.cid_block / 4) {
+        request_cids();
+    }
+    return true;
+}
+
+/* all members of the group are ours, so the local PMIx server
+ * has already completed the collective - all that is left is to
+ * assign the context id if one was requested */
+static void local_group(prrte_pmix_mdx_caddy_t *cd)
+{
+    prrte_buffer_t buf;
+    size_t cid;
+    int rc;
+
+    PRRTE_CONSTRUCT(&buf, prrte_buffer_t);
+    if (1 == cd->mode) {
+        if (!get_cid(&cid)) {
+            /* wait for the next block to arrive */
+            PRRTE_DESTRUCT(&buf);
+            if (0 > prrte_pointer_array_add(&prrte_pmix_server_globals.cid_waiting, cd)) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                group_release(PRRTE_ERR_OUT_OF_RESOURCE, NULL, cd);
+                return;
+            }
+            request_cids();
+            return;
+        }
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&buf, &cid, 1, PRRTE_SIZE))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&buf);
+            group_release(rc, NULL, cd);
+            return;
+        }
+    }
+    /* our contribution is the only one */
+    prrte_dss.copy_payload(&buf, cd->buf);
+    group_release(PRRTE_SUCCESS, &buf, cd);
+    PRRTE_DESTRUCT(&buf);
+}
+
+void pmix_server_cid_recv(int status, prrte_process_name_t* sender,
+                          prrte_buffer_t *buffer,
+                          prrte_rml_tag_t tg, void *cbdata)
+{
+    prrte_pmix_mdx_caddy_t *cd;
+    prrte_buffer_t *reply;
+    size_t start, n;
+    int32_t cnt;
+    int rc, i;
+
+    if (PRRTE_PROC_IS_MASTER) {
+        /* a daemon wants a block of ids - if we can't tell how
+         * many, then reply with none so it doesn't wait on us */
+        cnt = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &n, &cnt, PRRTE_SIZE))) {
+            PRRTE_ERROR_LOG(rc);
+            n = 0;
+        }
+        start = prrte_grpcomm_base.context_id;
+        prrte_grpcomm_base.context_id += n;
+        reply = PRRTE_NEW(prrte_buffer_t);
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &start, 1, PRRTE_SIZE)) ||
+            PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &n, 1, PRRTE_SIZE))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_RELEASE(reply);
+            return;
+        }
+        if (0 > (rc = prrte_rml.send_buffer_nb(sender, reply, PRRTE_RML_TAG_CONTEXT_ID,
+                                              prrte_rml_send_callback, NULL))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_RELEASE(reply);
+        }
+        return;
+    }
+
+    /* this is our new block - any ids left in the prior
+     * one are simply abandoned */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &start, &cnt, PRRTE_SIZE))) {
+        PRRTE_ERROR_LOG(rc);
+        cid_fail(rc);
+        return;
+    }
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &n, &cnt, PRRTE_SIZE))) {
+        PRRTE_ERROR_LOG(rc);
+        cid_fail(rc);
+        return;
+    }
+    if (0 == n) {
+        /* the HNP could not give us any */
+        cid_fail(PRRTE_ERR_OUT_OF_RESOURCE);
+        return;
+    }
+    if (prrte_pmix_server_globals.cid_requested) {
+        prrte_event_evtimer_del(&prrte_pmix_server_globals.cid_timer);
+    }
+    prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                         "%s reserved context ids %lu-%lu",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         (unsigned long)start, (unsigned long)(start + n - 1));
+    prrte_pmix_server_globals.cid_next = start;
+    prrte_pmix_server_globals.cid_last = start + n;
+    prrte_pmix_server_globals.cid_requested = false;
+
+    /* serve the groups that were waiting on it */
+    for (i=0; i < prrte_pmix_server_globals.cid_waiting.size; i++) {
+        if (NULL == (cd = (prrte_pmix_mdx_caddy_t*)prrte_pointer_array_get_item(&prrte_pmix_server_globals.cid_waiting, i))) {
+            continue;
+        }
+        if (prrte_pmix_server_globals.cid_next == prrte_pmix_server_globals.cid_last) {
+            /* ran dry again */
+            request_cids();
+            break;
+        }
+        prrte_pointer_array_set_item(&prrte_pmix_server_globals.cid_waiting, i, NULL);
+        local_group(cd);
+    }
+}
+
+static void _group(int sd, short args, void *cbdata)
+{
+    prrte_pmix_mdx_caddy_t *cd = (prrte_pmix_mdx_caddy_t*)cbdata;
+    int rc;
+
+    PRRTE_ACQUIRE_OBJECT(cd);
+
+    /* if all members are ours, then there is no need for a
+     * global collective - provided we can assign any context
+     * id ourselves */
+    if (NULL != cd->sig &&
+        (0 == cd->mode || PRRTE_PROC_IS_MASTER || 0 < prrte_pmix_server_globals.cid_block) &&
+        pmix_server_all_local(cd->sig)) {
+        prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                             "%s group: all members local",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
+        local_group(cd);
+        return;
+    }
+
+    /* pass it to the global collective algorithm */
+    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.allgather(cd->sig, cd->buf, cd->mode,
+                                                     group_release, cd))) {
+        PRRTE_ERROR_LOG(rc);
+        group_release(rc, NULL, cd);
+    }
+}
+
 pmix_status_t pmix_server_group_fn(pmix_group_operation_t op, char *gpid,
                                    const pmix_proc_t procs[], size_t nprocs,
                                    const pmix_info_t directives[], size_t ndirs,
                                    pmix_info_cbfunc_t cbfunc, void *cbdata)
 {
     prrte_pmix_mdx_caddy_t *cd;
-    int rc;
     size_t i, mode = 0;
     pmix_server_pset_t *pset;
     bool fence = false;
@@ -1168,19 +1476,11 @@ pmix_status_t pmix_server_group_fn(pmix_group_operation_t op, char *gpid,
     cd->cbdata = cbdata;
     cd->mode = mode;
 
-   /* compute the signature of this collective */
+   /* get the signature of this collective */
     if (NULL != procs) {
-        cd->sig = PRRTE_NEW(prrte_grpcomm_signature_t);
-        cd->sig->sz = nprocs;
-        cd->sig->signature = (prrte_process_name_t*)malloc(cd->sig->sz * sizeof(prrte_process_name_t));
-        memset(cd->sig->signature, 0, cd->sig->sz * sizeof(prrte_process_name_t));
-        for (i=0; i < nprocs; i++) {
-            PRRTE_PMIX_CONVERT_PROCT(rc, &cd->sig->signature[i], &procs[i]);
-            if (PRRTE_SUCCESS != rc) {
-                PRRTE_ERROR_LOG(rc);
-                PRRTE_RELEASE(cd);
-                return PMIX_ERR_BAD_PARAM;
-            }
+        if (NULL == (cd->sig = group_signature(procs, nprocs))) {
+            PRRTE_RELEASE(cd);
+            return PMIX_ERR_BAD_PARAM;
         }
     }
     cd->buf = PRRTE_NEW(prrte_buffer_t);
@@ -1195,13 +1495,9 @@ pmix_status_t pmix_server_group_fn(pmix_group_operation_t op, char *gpid,
         /* don't destruct bf! */
     }
 #endif
-    /* pass it to the global collective algorithm */
-    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.allgather(cd->sig, cd->buf, mode,
-                                                     group_release, cd))) {
-        PRRTE_ERROR_LOG(rc);
-        PRRTE_RELEASE(cd);
-        return PMIX_ERROR;
-    }
+    /* the member and context id tracking is ours, so
+     * shift into our event base to complete it */
+    PRRTE_THREADSHIFT(cd, prrte_event_base, _group, PRRTE_MSG_PRI);
     return PMIX_SUCCESS;
 }
 #endif
@@ -41,6 +41,7 @@
 
 #include "types.h"
 #include "src/class/prrte_hotel.h"
+#include "src/class/prrte_hash_table.h"
 #include "src/mca/base/base.h"
 #include "src/event/event-internal.h"
 #include "src/pmix/pmix-internal.h"
@@ -77,7 +78,7 @@ BEGIN_C_DECLS
 
 /* object for tracking requests so we can
  * correctly route the eventual reply */
- typedef struct {
+ typedef struct pmix_server_req_t {
     prrte_object_t super;
     prrte_event_t ev;
     char *operation;
@@ -101,6 +102,11 @@ BEGIN_C_DECLS
     prrte_process_name_t proxy;
     prrte_process_name_t target;
     pmix_proc_t tproc;
+    /* chain of dmodex requests pending on the same target */
+    bool dmdx_indexed;
+    struct pmix_server_req_t *dmdx_next;
+    /* speculative dmodex request that nobody is waiting on */
+    bool dmdx_prefetch;
     prrte_job_t *jdata;
     prrte_buffer_t msg;
     pmix_op_cbfunc_t opcbfunc;
@@ -146,6 +152,7 @@ PRRTE_CLASS_DECLARATION(prrte_pmix_server_op_caddy_t);
 
 typedef struct {
     prrte_object_t super;
+    prrte_event_t ev;
     prrte_grpcomm_signature_t *sig;
     prrte_buffer_t *buf;
     pmix_modex_cbfunc_t cbfunc;
@@ -326,8 +333,16 @@ extern pmix_status_t pmix_server_group_fn(pmix_group_operation_t op, char *gpid,
                                           const pmix_proc_t procs[], size_t nprocs,
                                           const pmix_info_t directives[], size_t ndirs,
                                           pmix_info_cbfunc_t cbfunc, void *cbdata);
+
+/* requests for, and replies carrying, blocks of context ids */
+extern void pmix_server_cid_recv(int status, prrte_process_name_t* sender,
+                                 prrte_buffer_t *buffer,
+                                 prrte_rml_tag_t tg, void *cbdata);
 #endif
 
+/* check if all the procs in a signature are hosted by us */
+extern bool pmix_server_all_local(prrte_grpcomm_signature_t *sig);
+
 void prrte_pmix_server_tool_conn_complete(prrte_job_t *jdata,
                                          pmix_server_req_t *req);
 
@@ -344,6 +359,38 @@ extern void pmix_server_notify(int status, prrte_process_name_t* sender,
                                prrte_buffer_t *buffer,
                                prrte_rml_tag_t tg, void *cbdata);
 
+/* index of the direct modex requests awaiting data from a
+ * target proc, so that duplicate requests can be coalesced. The
+ * first request tracked for a target is the one that actually
+ * asked for the data, and is returned by the lookup */
+extern void pmix_server_dmdx_track(pmix_server_req_t *req);
+extern pmix_server_req_t* pmix_server_dmdx_pending(prrte_process_name_t *target);
+/* remove all requests pending on the target from the index,
+ * returning them as a chain linked thru dmdx_next */
+extern pmix_server_req_t* pmix_server_dmdx_detach(prrte_process_name_t *target);
+/* the given request was the one fetching the data for its target
+ * and has failed - nobody queued behind it will get the data either,
+ * so pass them the status and release them */
+extern void pmix_server_dmdx_abort(pmix_server_req_t *req, pmix_status_t status);
+
+/* blobs for remote procs that were prefetched before anyone asked
+ * for them. If one is held for the target of the request, it is
+ * passed to the request's callback and dropped from the cache */
+extern bool pmix_server_dmdx_cached(prrte_process_name_t *target);
+extern bool pmix_server_dmdx_serve_cached(pmix_server_req_t *req);
+
+/* send a direct modex request or response to the given daemon. The
+ * payload is aggregated with any others headed for the same daemon
+ * and tag, and the batch is sent once it is full or the batch window
+ * expires. Ownership of the data is taken in all cases */
+extern int pmix_server_dmdx_send(prrte_process_name_t *dmn, prrte_rml_tag_t tag,
+                                 char *data, size_t sz);
+
+/* add a log record to the batch for our HNP, which is sent once
+ * it holds enough records or the batch window expires. The
+ * record is copied */
+extern int pmix_server_log_send(prrte_buffer_t *rec);
+
 /* exposed shared variables */
 typedef struct {
   prrte_list_item_t super;
@@ -358,6 +405,22 @@ typedef struct {
     int verbosity;
     int output;
     prrte_hotel_t reqs;
+    prrte_hash_table_t dmdx_reqs;
+    prrte_hash_table_t dmdx_batches;
+    int dmdx_batch_size;
+    int dmdx_batch_window;
+    bool dmdx_prefetch;
+    prrte_hash_table_t dmdx_cache;
+    int log_batch_size;
+    int log_batch_window;
+    prrte_hash_table_t grp_sigs;
+    prrte_hash_table_t proc_tables;
+    int cid_block;
+    size_t cid_next;
+    size_t cid_last;
+    bool cid_requested;
+    prrte_pointer_array_t cid_waiting;
+    prrte_event_t cid_timer;
     int num_rooms;
     int timeout;
     bool wait_for_server;
@@ -368,6 +431,7 @@ typedef struct {
     bool system_server;
     bool legacy;
     prrte_list_t psets;
+    bool compact_registration;
 } pmix_server_globals_t;
 
 extern pmix_server_globals_t prrte_pmix_server_globals;
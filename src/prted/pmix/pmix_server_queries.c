@@ -53,9 +53,263 @@
 
 #include "pmix_server_internal.h"
 
+#ifdef PMIX_QUERY_PROC_TABLE
+/* snapshot of the proc table of a job (or of its local procs),
+ * kept up to date from one query to the next. The snapshot is
+ * lent to the replies, so it is only patched in place when no
+ * reply holds it - otherwise a fresh one takes its place */
+typedef struct {
+    prrte_object_t super;
+    size_t nprocs;
+    pmix_proc_info_t *table;
+    /* epoch at which each entry last changed */
+    uint32_t *epochs;
+    uint32_t epoch;
+} proc_table_t;
+static void ptcon(proc_table_t *p)
+{
+    p->nprocs = 0;
+    p->table = NULL;
+    p->epochs = NULL;
+    p->epoch = 0;
+}
+static void ptdes(proc_table_t *p)
+{
+    if (NULL != p->table) {
+        PMIX_PROC_INFO_FREE(p->table, p->nprocs);
+    }
+    if (NULL != p->epochs) {
+        free(p->epochs);
+    }
+}
+static PRRTE_CLASS_INSTANCE(proc_table_t,
+                            prrte_object_t,
+                            ptcon, ptdes);
+
+static bool entry_differs(pmix_proc_info_t *pi, prrte_proc_t *proct)
+{
+    return (pi->pid != proct->pid ||
+            pi->exit_code != proct->exit_code ||
+            pi->state != prrte_pmix_convert_state(proct->state));
+}
+
+static proc_table_t* build_table(prrte_job_t *jdata, bool local)
+{
+    proc_table_t *tbl;
+    prrte_proc_t *proct;
+    prrte_app_context_t *app;
+    pmix_proc_info_t *pi;
+    size_t p;
+    int k;
+
+    tbl = PRRTE_NEW(proc_table_t);
+    tbl->nprocs = local ? jdata->num_local_procs : jdata->num_procs;
+    if (0 == tbl->nprocs) {
+        return tbl;
+    }
+    PMIX_PROC_INFO_CREATE(tbl->table, tbl->nprocs);
+    tbl->epochs = (uint32_t*)calloc(tbl->nprocs, sizeof(uint32_t));
+    p = 0;
+    for (k=0; k < jdata->procs->size && p < tbl->nprocs; k++) {
+        if (NULL == (proct = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, k))) {
+            continue;
+        }
+        if (local && !PRRTE_FLAG_TEST(proct, PRRTE_PROC_FLAG_LOCAL)) {
+            continue;
+        }
+        pi = &tbl->table[p];
+        PRRTE_PMIX_CONVERT_NAME(&pi->proc, &proct->name);
+        if (NULL != proct->node && NULL != proct->node->name) {
+            pi->hostname = strdup(proct->node->name);
+        }
+        app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, proct->app_idx);
+        if (NULL != app && NULL != app->app) {
+            pi->executable_name = strdup(app->app);
+        }
+        pi->pid = proct->pid;
+        pi->exit_code = proct->exit_code;
+        pi->state = prrte_pmix_convert_state(proct->state);
+        ++p;
+    }
+    /* in case the counts were off */
+    tbl->nprocs = p;
+    return tbl;
+}
+
+/* get the current proc table for the job, bringing the cached
+ * snapshot up to date with any proc state changes */
+static proc_table_t* get_table(prrte_job_t *jdata, bool local)
+{
+    proc_table_t *tbl = NULL, *fresh;
+    prrte_proc_t *proct;
+    uint64_t key;
+    size_t p, n;
+    bool stale = false, changed = false;
+
+    key = ((uint64_t)jdata->jobid << 1) | (local ? 1 : 0);
+    n = local ? jdata->num_local_procs : jdata->num_procs;
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_pmix_server_globals.proc_tables,
+                                                           key, (void**)&tbl)) {
+        if (n != tbl->nprocs) {
+            stale = true;
+        } else {
+            for (p=0; p < tbl->nprocs; p++) {
+                proct = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, tbl->table[p].proc.rank);
+                if (NULL == proct) {
+                    stale = true;
+                    break;
+                }
+                if (entry_differs(&tbl->table[p], proct)) {
+                    changed = true;
+                    if (1 < tbl->super.obj_reference_count) {
+                        /* lent to a reply - can't touch it */
+                        stale = true;
+                        break;
+                    }
+                    tbl->table[p].pid = proct->pid;
+                    tbl->table[p].exit_code = proct->exit_code;
+                    tbl->table[p].state = prrte_pmix_convert_state(proct->state);
+                    tbl->epochs[p] = tbl->epoch + 1;
+                }
+            }
+        }
+        if (!stale) {
+            if (changed) {
+                ++tbl->epoch;
+            }
+            return tbl;
+        }
+    }
+
+    fresh = build_table(jdata, local);
+    if (NULL == tbl) {
+        fresh->epoch = 1;
+        for (p=0; p < fresh->nprocs; p++) {
+            fresh->epochs[p] = 1;
+        }
+    } else {
+        /* carry forward the epochs of whatever didn't change */
+        fresh->epoch = tbl->epoch + 1;
+        for (p=0; p < fresh->nprocs; p++) {
+            if (p < tbl->nprocs &&
+                fresh->table[p].proc.rank == tbl->table[p].proc.rank &&
+                fresh->table[p].pid == tbl->table[p].pid &&
+                fresh->table[p].exit_code == tbl->table[p].exit_code &&
+                fresh->table[p].state == tbl->table[p].state) {
+                fresh->epochs[p] = tbl->epochs[p];
+            } else {
+                fresh->epochs[p] = fresh->epoch;
+            }
+        }
+        PRRTE_RELEASE(tbl);
+    }
+    prrte_hash_table_set_value_uint64(&prrte_pmix_server_globals.proc_tables, key, fresh);
+    return fresh;
+}
+
+/* load the proc table into the reply - the full table is lent
+ * to it rather than copied, while a delta gets its own copy of
+ * just the entries that changed since the given epoch */
+static void load_table(prrte_info_item_t *kv, proc_table_t *tbl,
+                       bool delta, uint32_t since,
+                       prrte_pointer_array_t **borrowed)
+{
+    pmix_data_array_t *darray;
+    pmix_proc_info_t *pi;
+    size_t p, n;
+
+    if (!delta) {
+        darray = (pmix_data_array_t*)malloc(sizeof(pmix_data_array_t));
+        darray->type = PMIX_PROC_INFO;
+        darray->size = tbl->nprocs;
+        darray->array = tbl->table;
+        if (NULL == *borrowed) {
+            *borrowed = PRRTE_NEW(prrte_pointer_array_t);
+            prrte_pointer_array_init(*borrowed, 2, INT_MAX, 2);
+        }
+        PRRTE_RETAIN(tbl);
+        prrte_pointer_array_add(*borrowed, tbl);
+    } else {
+        n = 0;
+        for (p=0; p < tbl->nprocs; p++) {
+            if (since < tbl->epochs[p]) {
+                ++n;
+            }
+        }
+        PMIX_DATA_ARRAY_CREATE(darray, n, PMIX_PROC_INFO);
+    #if PMIX_NUMERIC_VERSION < 0x00030100
+        PMIX_PROC_INFO_CREATE(darray->array, n);
+    #endif
+        pi = (pmix_proc_info_t*)darray->array;
+        n = 0;
+        for (p=0; p < tbl->nprocs; p++) {
+            if (since >= tbl->epochs[p]) {
+                continue;
+            }
+            memcpy(&pi[n].proc, &tbl->table[p].proc, sizeof(pmix_proc_t));
+            if (NULL != tbl->table[p].hostname) {
+                pi[n].hostname = strdup(tbl->table[p].hostname);
+            }
+            if (NULL != tbl->table[p].executable_name) {
+                pi[n].executable_name = strdup(tbl->table[p].executable_name);
+            }
+            pi[n].pid = tbl->table[p].pid;
+            pi[n].exit_code = tbl->table[p].exit_code;
+            pi[n].state = tbl->table[p].state;
+            ++n;
+        }
+    }
+    kv->info.value.type = PMIX_DATA_ARRAY;
+    kv->info.value.data.darray = darray;
+}
+
+/* detach the tables that were lent to a reply so they
+ * aren't released along with it */
+static void detach_tables(pmix_info_t *info, size_t ninfo,
+                          prrte_pointer_array_t *borrowed)
+{
+    proc_table_t *tbl;
+    size_t n;
+    int k;
+
+    for (k=0; k < borrowed->size; k++) {
+        if (NULL == (tbl = (proc_table_t*)prrte_pointer_array_get_item(borrowed, k))) {
+            continue;
+        }
+        for (n=0; n < ninfo; n++) {
+            if (PMIX_DATA_ARRAY == info[n].value.type &&
+                NULL != info[n].value.data.darray &&
+                tbl->table == info[n].value.data.darray->array) {
+                info[n].value.data.darray->array = NULL;
+                info[n].value.data.darray->size = 0;
+            }
+        }
+    }
+}
+
+static void return_tables(prrte_pointer_array_t *borrowed)
+{
+    proc_table_t *tbl;
+    int k;
+
+    for (k=0; k < borrowed->size; k++) {
+        if (NULL != (tbl = (proc_table_t*)prrte_pointer_array_get_item(borrowed, k))) {
+            PRRTE_RELEASE(tbl);
+        }
+    }
+    PRRTE_RELEASE(borrowed);
+}
+#endif
+
 static void qrel(void *cbdata)
 {
     prrte_pmix_server_op_caddy_t *cd = (prrte_pmix_server_op_caddy_t*)cbdata;
+#ifdef PMIX_QUERY_PROC_TABLE
+    if (NULL != cd->server_object) {
+        detach_tables(cd->info, cd->ninfo, (prrte_pointer_array_t*)cd->server_object);
+        return_tables((prrte_pointer_array_t*)cd->server_object);
+    }
+#endif
     if (NULL != cd->info) {
         PMIX_INFO_FREE(cd->info, cd->ninfo);
     }
@@ -82,7 +336,8 @@ static void _query(int sd, short args, void *cbdata)
     char *cmdline;
 #endif
     char **ans, *tmp;
-    prrte_process_name_t requestor;
+    prrte_process_name_t requestor, target;
+    prrte_vpid_t vpid;
     prrte_app_context_t *app;
     prrte_pstats_t pstat;
     float pss;
@@ -90,13 +345,18 @@ static void _query(int sd, short args, void *cbdata)
     prrte_namelist_t *nm;
     prrte_list_t targets;
     int i, num_replies;
-    pmix_proc_info_t *procinfo;
     pmix_info_t *info;
     pmix_data_array_t *darray;
     prrte_proc_t *proct;
 #if PMIX_NUMERIC_VERSION >= 0x00040000
     size_t sz;
 #endif
+#ifdef PMIX_QUERY_PROC_TABLE
+    proc_table_t *tbl;
+    prrte_pointer_array_t *borrowed = NULL;
+    bool delta;
+    uint32_t since = 0;
+#endif
 
     PRRTE_ACQUIRE_OBJECT(cd);
 
@@ -120,6 +380,10 @@ static void _query(int sd, short args, void *cbdata)
         nodeid = UINT32_MAX;
         /* default to the requestor's jobid */
         jobid = requestor.jobid;
+        vpid = PRRTE_VPID_WILDCARD;
+#ifdef PMIX_QUERY_PROC_TABLE
+        delta = false;
+#endif
         /* see if they provided any qualifiers */
         if (NULL != q->qualifiers && 0 < q->nqual) {
             for (n=0; n < q->nqual; n++) {
@@ -133,6 +397,13 @@ static void _query(int sd, short args, void *cbdata)
                     hostname = q->qualifiers[n].value.data.string;
                 } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NODEID)) {
                     PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, nodeid, uint32_t);
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_RANK)) {
+                    PRRTE_PMIX_CONVERT_RANK(vpid, q->qualifiers[n].value.data.rank);
+#ifdef PMIX_QUERY_PROC_TABLE
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRRTE_PMIX_QUERY_EPOCH)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, since, uint32_t);
+                    delta = (PRRTE_SUCCESS == rc);
+#endif
                 }
             }
         }
@@ -346,6 +617,18 @@ static void _query(int sd, short args, void *cbdata)
                     prrte_list_append(&results, &kv->super);
                 }
             #endif
+            } else if (0 == strcmp(q->keys[n], PRRTE_PMIX_QUERY_IOF_TAIL)) {
+                /* only the HNP knows where everyone is, and it
+                 * holds the sinks of the tools */
+                if (PRRTE_PROC_IS_MASTER && NULL != prrte_iof.tail) {
+                    target.jobid = jobid;
+                    target.vpid = vpid;
+                    if (PRRTE_SUCCESS == (rc = prrte_iof.tail(&target, &requestor))) {
+                        kv = PRRTE_NEW(prrte_info_item_t);
+                        PMIX_INFO_LOAD(&kv->info, PRRTE_PMIX_QUERY_IOF_TAIL, NULL, PMIX_BOOL);
+                        prrte_list_append(&results, &kv->super);
+                    }
+                }
             } else if (0 == strcmp(q->keys[n], PMIX_PROC_URI)) {
                 /* they want our URI */
                 kv = PRRTE_NEW(prrte_info_item_t);
@@ -409,84 +692,25 @@ static void _query(int sd, short args, void *cbdata)
                 free(uri);
                 prrte_list_append(&results, &kv->super);
     #ifdef PMIX_QUERY_PROC_TABLE
-            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_PROC_TABLE)) {
+            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_PROC_TABLE) ||
+                       0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE)) {
                 /* construct a list of values with prrte_proc_info_t
-                 * entries for each proc in the indicated job */
+                 * entries for each (LOCAL) proc in the indicated job */
                 jdata = prrte_get_job_data_object(jobid);
                 if (NULL == jdata) {
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
+                tbl = get_table(jdata, 0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE));
                 /* setup the reply */
                 kv = PRRTE_NEW(prrte_info_item_t);
-                (void)strncpy(kv->info.key, PMIX_QUERY_PROC_TABLE, PMIX_MAX_KEYLEN);
+                (void)strncpy(kv->info.key, q->keys[n], PMIX_MAX_KEYLEN);
                 prrte_list_append(&results, &kv->super);
-                 /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_procs, PMIX_PROC_INFO);
-                kv->info.value.type = PMIX_DATA_ARRAY;
-                kv->info.value.data.darray = darray;
-        #if PMIX_NUMERIC_VERSION < 0x00030100
-                PMIX_PROC_INFO_CREATE(darray->array, jdata->num_local_procs);
-        #endif
-                procinfo = (pmix_proc_info_t*)darray->array;
-                p = 0;
-                for (k=0; k < jdata->procs->size; k++) {
-                    if (NULL == (proct = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, k))) {
-                        continue;
-                    }
-                    PRRTE_PMIX_CONVERT_NAME(&procinfo[p].proc, &proct->name);
-                    if (NULL != proct->node && NULL != proct->node->name) {
-                        procinfo[p].hostname = strdup(proct->node->name);
-                    }
-                    app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, proct->app_idx);
-                    if (NULL != app && NULL != app->app) {
-                        procinfo[p].executable_name = strdup(app->app);
-                    }
-                    procinfo[p].pid = proct->pid;
-                    procinfo[p].exit_code = proct->exit_code;
-                    procinfo[p].state = prrte_pmix_convert_state(proct->state);
-                    ++p;
-                }
-            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE)) {
-                /* construct a list of values with prrte_proc_info_t
-                 * entries for each LOCAL proc in the indicated job */
-                jdata = prrte_get_job_data_object(jobid);
-                if (NULL == jdata) {
-                    rc = PRRTE_ERR_NOT_FOUND;
-                    goto done;
-                }
-                /* setup the reply */
+                load_table(kv, tbl, delta, since, &borrowed);
+                /* let them know where the table stands */
                 kv = PRRTE_NEW(prrte_info_item_t);
-                (void)strncpy(kv->info.key, PMIX_QUERY_LOCAL_PROC_TABLE, PMIX_MAX_KEYLEN);
+                PMIX_INFO_LOAD(&kv->info, PRRTE_PMIX_QUERY_EPOCH, &tbl->epoch, PMIX_UINT32);
                 prrte_list_append(&results, &kv->super);
-                /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_local_procs, PMIX_PROC_INFO);
-                kv->info.value.type = PMIX_DATA_ARRAY;
-                kv->info.value.data.darray = darray;
-        #if PMIX_NUMERIC_VERSION < 0x00030100
-                PMIX_PROC_INFO_CREATE(darray->array, jdata->num_local_procs);
-        #endif
-                procinfo = (pmix_proc_info_t*)darray->array;
-                p = 0;
-                for (k=0; k < jdata->procs->size; k++) {
-                    if (NULL == (proct = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, k))) {
-                        continue;
-                    }
-                    if (PRRTE_FLAG_TEST(proct, PRRTE_PROC_FLAG_LOCAL)) {
-                        PRRTE_PMIX_CONVERT_NAME(&procinfo[p].proc, &proct->name);
-                        if (NULL != proct->node && NULL != proct->node->name) {
-                            procinfo[p].hostname = strdup(proct->node->name);
-                        }
-                        app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, proct->app_idx);
-                        if (NULL != app && NULL != app->app) {
-                            procinfo[p].executable_name = strdup(app->app);
-                        }
-                        procinfo[p].pid = proct->pid;
-                        procinfo[p].exit_code = proct->exit_code;
-                        procinfo[p].state = prrte_pmix_convert_state(proct->state);
-                        ++p;
-                    }
-                }
     #endif
     #ifdef PMIX_QUERY_NUM_PSETS
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_NUM_PSETS)) {
@@ -542,11 +766,27 @@ static void _query(int sd, short args, void *cbdata)
             PMIX_INFO_CREATE(rcd->info, rcd->ninfo);
             n=0;
             PRRTE_LIST_FOREACH(kv, &results, prrte_info_item_t) {
-                PMIX_INFO_XFER(&rcd->info[n], &kv->info);
+                /* move the value so anything lent to us
+                 * goes with it rather than being copied */
+                memcpy(&rcd->info[n], &kv->info, sizeof(pmix_info_t));
+                kv->info.value.type = PMIX_UNDEF;
                 n++;
             }
         }
     }
+#ifdef PMIX_QUERY_PROC_TABLE
+    if (NULL != borrowed) {
+        if (NULL == rcd->info) {
+            /* never made it into a reply */
+            PRRTE_LIST_FOREACH(kv, &results, prrte_info_item_t) {
+                detach_tables(&kv->info, 1, borrowed);
+            }
+            return_tables(borrowed);
+        } else {
+            rcd->server_object = borrowed;
+        }
+    }
+#endif
     PRRTE_LIST_DESTRUCT(&results);
     cd->infocbfunc(ret, rcd->info, rcd->ninfo, cd->cbdata, qrel, rcd);
     PRRTE_RELEASE(cd);
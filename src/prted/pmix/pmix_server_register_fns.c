@@ -31,6 +31,7 @@
 
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
+#include <assert.h>
 #endif
 #include <fcntl.h>
 #include <pmix_server.h>
@@ -55,17 +56,66 @@
 
 static void opcbfunc(pmix_status_t status, void *cbdata);
 
+/* The registration payload is built directly into pmix_info_t arrays
+ * that are sized up front for the expected number of entries, rather
+ * than creating a list item for every value and converting the list
+ * into an array afterwards. Everything hangs off the job-level array,
+ * so the whole structure is released in one shot by PMIX_INFO_FREE */
+#define PRRTE_PMIX_REG_JOB_INFO     32
+#define PRRTE_PMIX_REG_PROC_INFO    16
+
+typedef struct {
+    pmix_info_t *info;
+    size_t ninfo;
+    size_t size;
+    /* entries that didn't fit are loaded here and discarded - the
+     * registration is abandoned once the array is complete */
+    pmix_info_t sink;
+    bool failed;
+} reg_array_t;
+
+/* load the next per-proc value into the scratch array */
+#define PRRTE_PMIX_REG_PROC_LOAD(k, v, t)               \
+    do {                                                \
+        assert(p < PRRTE_PMIX_REG_PROC_INFO);           \
+        PMIX_INFO_LOAD(&pmap[p], (k), (v), (t));        \
+        ++p;                                            \
+    } while (0)
+
+/* get the next free entry in the array, growing it if
+ * our estimate of the size turns out to be too small. Never
+ * returns NULL so callers can load the entry directly */
+static pmix_info_t* reg_next(reg_array_t *r)
+{
+    pmix_info_t *tmp;
+    size_t n;
+
+    if (r->ninfo == r->size) {
+        n = (0 == r->size) ? PRRTE_PMIX_REG_JOB_INFO : 2 * r->size;
+        tmp = (pmix_info_t*)realloc(r->info, n * sizeof(pmix_info_t));
+        if (NULL == tmp) {
+            PMIX_INFO_DESTRUCT(&r->sink);
+            PMIX_INFO_CONSTRUCT(&r->sink);
+            r->failed = true;
+            return &r->sink;
+        }
+        memset(&tmp[r->size], 0, (n - r->size) * sizeof(pmix_info_t));
+        r->info = tmp;
+        r->size = n;
+    }
+    return &r->info[r->ninfo++];
+}
+
 /* stuff proc attributes for sending back to a proc */
 int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
 {
     int rc;
     prrte_proc_t *pptr;
     int i, k, n, p;
-    prrte_list_t *info, *pmap;
-    prrte_info_item_t *kv, *kptr;
     prrte_node_t *node, *mynode;
     prrte_vpid_t vpid;
-    char **list, **procs, **micro, *tmp, *regex;
+    char **list, **procs, **micro, *tmp, *regex, *str;
+    char **procdirs, *nsdir;
     prrte_job_t *dmns;
     prrte_job_map_t *map;
     prrte_app_context_t *app;
@@ -75,62 +125,85 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
     hwloc_obj_t machine;
     pmix_proc_t pproc;
     pmix_status_t ret;
-    pmix_info_t *pinfo;
+    pmix_info_t *pinfo, *pmap;
+    pmix_info_t pscratch[PRRTE_PMIX_REG_PROC_INFO];
     size_t ninfo;
     prrte_pmix_lock_t lock;
-    prrte_list_t local_procs;
-    prrte_namelist_t *nm;
+    reg_array_t reg;
     size_t nmsize;
     pmix_server_pset_t *pset;
     prrte_value_t *val;
     uint32_t ui32;
+    bool compact;
 
     prrte_output_verbose(2, prrte_pmix_server_globals.output,
                         "%s register nspace for %s",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                         PRRTE_JOBID_PRINT(jdata->jobid));
 
-    /* setup the info list */
-    info = PRRTE_NEW(prrte_list_t);
+    /* see if we are only registering proc-level data for our local
+     * procs - the PMIx server can derive the basic info for remote
+     * procs (e.g., host and node-level ranks) from the node and
+     * proc maps, and anything else is retrieved by direct modex. The
+     * app-level info cannot be derived from the maps, so MPMD jobs are
+     * always fully registered */
+    compact = prrte_pmix_server_globals.compact_registration && 1 == jdata->num_apps;
+    if (compact) {
+        prrte_output_verbose(2, prrte_pmix_server_globals.output,
+                            "%s using compact registration for %s",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            PRRTE_JOBID_PRINT(jdata->jobid));
+    }
+
+    /* setup the info array - we need the job-level values
+     * plus one entry for each proc we register */
+    reg.info = NULL;
+    reg.ninfo = 0;
+    reg.size = 0;
+    PMIX_INFO_CONSTRUCT(&reg.sink);
+    reg.failed = false;
+    ninfo = PRRTE_PMIX_REG_JOB_INFO + (compact ? jdata->num_local_procs : jdata->num_procs);
+    cache = NULL;
+    if (prrte_get_attribute(&jdata->attributes, PRRTE_JOB_INFO_CACHE, (void**)&cache, PRRTE_PTR) &&
+        NULL != cache) {
+        ninfo += prrte_list_get_size(cache);
+    }
+    PMIX_INFO_CREATE(reg.info, ninfo);
+    if (NULL == reg.info) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    reg.size = ninfo;
     uid = geteuid();
     gid = getegid();
 
     /* pass our nspace/rank */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_LOAD_KEY(kv->info.key, PMIX_SERVER_NSPACE);
-    kv->info.value.type = PMIX_PROC;
+    pinfo = reg_next(&reg);
+    PMIX_LOAD_KEY(pinfo->key, PMIX_SERVER_NSPACE);
+    pinfo->value.type = PMIX_PROC;
     /* have to stringify the jobid */
-    PMIX_PROC_CREATE(kv->info.value.data.proc, 1);
-    PRRTE_PMIX_CONVERT_JOBID(kv->info.value.data.proc->nspace, PRRTE_PROC_MY_NAME->jobid);
-    prrte_list_append(info, &kv->super);
+    PMIX_PROC_CREATE(pinfo->value.data.proc, 1);
+    PRRTE_PMIX_CONVERT_JOBID(pinfo->value.data.proc->nspace, PRRTE_PROC_MY_NAME->jobid);
 
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_SERVER_RANK, &PRRTE_PROC_MY_NAME->vpid, PMIX_PROC_RANK);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_SERVER_RANK, &PRRTE_PROC_MY_NAME->vpid, PMIX_PROC_RANK);
 
     /* jobid */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_LOAD_KEY(kv->info.key, PMIX_JOBID);
-    kv->info.value.type = PMIX_PROC;
+    pinfo = reg_next(&reg);
+    PMIX_LOAD_KEY(pinfo->key, PMIX_JOBID);
+    pinfo->value.type = PMIX_PROC;
     /* have to stringify the jobid */
-    PMIX_PROC_CREATE(kv->info.value.data.proc, 1);
-    PRRTE_PMIX_CONVERT_JOBID(kv->info.value.data.proc->nspace, jdata->jobid);
-    prrte_list_append(info, &kv->super);
+    PMIX_PROC_CREATE(pinfo->value.data.proc, 1);
+    PRRTE_PMIX_CONVERT_JOBID(pinfo->value.data.proc->nspace, jdata->jobid);
 
     /* offset */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NPROC_OFFSET, &jdata->offset, PMIX_PROC_RANK);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_NPROC_OFFSET, &jdata->offset, PMIX_PROC_RANK);
 
     /* check for cached values to add to the job info */
-    cache = NULL;
-    if (prrte_get_attribute(&jdata->attributes, PRRTE_JOB_INFO_CACHE, (void**)&cache, PRRTE_PTR) &&
-        NULL != cache) {
+    if (NULL != cache) {
         while (NULL != (val = (prrte_value_t*)prrte_list_remove_first(cache))) {
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_LOAD_KEY(kv->info.key, val->key);
-            prrte_pmix_value_load(&kv->info.value, val);
-            prrte_list_append(info, &kv->super);
+            pinfo = reg_next(&reg);
+            PMIX_LOAD_KEY(pinfo->key, val->key);
+            prrte_pmix_value_load(&pinfo->value, val);
             PRRTE_RELEASE(val);
         }
         prrte_remove_attribute(&jdata->attributes, PRRTE_JOB_INFO_CACHE);
@@ -170,18 +243,16 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
         if (PRRTE_SUCCESS != (rc = PMIx_generate_regex(tmp, &regex))) {
             PRRTE_ERROR_LOG(rc);
             free(tmp);
-            PRRTE_LIST_RELEASE(info);
+            PMIX_INFO_FREE(reg.info, reg.ninfo);
             return rc;
         }
         free(tmp);
-        kv = PRRTE_NEW(prrte_info_item_t);
 #ifdef PMIX_REGEX
-        PMIX_INFO_LOAD(&kv->info, PMIX_NODE_MAP, regex, PMIX_REGEX);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_NODE_MAP, regex, PMIX_REGEX);
 #else
-        PMIX_INFO_LOAD(&kv->info, PMIX_NODE_MAP, regex, PMIX_STRING);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_NODE_MAP, regex, PMIX_STRING);
 #endif
         free(regex);
-        prrte_list_append(info, &kv->super);
     }
 
     /* let the PMIx server generate the procmap regex */
@@ -192,119 +263,89 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
         if (PRRTE_SUCCESS != (rc = PMIx_generate_ppn(tmp, &regex))) {
             PRRTE_ERROR_LOG(rc);
             free(tmp);
-            PRRTE_LIST_RELEASE(info);
+            PMIX_INFO_FREE(reg.info, reg.ninfo);
             return rc;
         }
         free(tmp);
-        kv = PRRTE_NEW(prrte_info_item_t);
 #ifdef PMIX_REGEX
-        PMIX_INFO_LOAD(&kv->info, PMIX_PROC_MAP, regex, PMIX_REGEX);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_PROC_MAP, regex, PMIX_REGEX);
 #else
-        PMIX_INFO_LOAD(&kv->info, PMIX_PROC_MAP, regex, PMIX_STRING);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_PROC_MAP, regex, PMIX_STRING);
 #endif
         free(regex);
-        prrte_list_append(info, &kv->super);
     }
 
     /* get our local node */
     if (NULL == (dmns = prrte_get_job_data_object(PRRTE_PROC_MY_NAME->jobid))) {
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        PRRTE_LIST_RELEASE(info);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
         return PRRTE_ERR_NOT_FOUND;
     }
     if (NULL == (pptr = (prrte_proc_t*)prrte_pointer_array_get_item(dmns->procs, PRRTE_PROC_MY_NAME->vpid))) {
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        PRRTE_LIST_RELEASE(info);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
         return PRRTE_ERR_NOT_FOUND;
     }
     mynode = pptr->node;
     if (NULL == mynode) {
         /* cannot happen */
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        PRRTE_LIST_RELEASE(info);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
         return PRRTE_ERR_NOT_FOUND;
     }
 
     /* pass our hostname */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME, prrte_process_info.nodename, PMIX_STRING);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_HOSTNAME, prrte_process_info.nodename, PMIX_STRING);
 
     /* pass our node ID */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NODEID, &mynode->index, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_NODEID, &mynode->index, PMIX_UINT32);
 
     /* pass our node size */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NODE_SIZE, &mynode->num_procs, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_NODE_SIZE, &mynode->num_procs, PMIX_UINT32);
 
     /* pass the number of nodes in the job */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NUM_NODES, &map->num_nodes, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_NUM_NODES, &map->num_nodes, PMIX_UINT32);
 
     /* univ size */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_UNIV_SIZE, &jdata->total_slots_alloc, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_UNIV_SIZE, &jdata->total_slots_alloc, PMIX_UINT32);
 
     /* job size */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_JOB_SIZE, &jdata->num_procs, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_JOB_SIZE, &jdata->num_procs, PMIX_UINT32);
 
     /* number of apps in this job */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_JOB_NUM_APPS, &jdata->num_apps, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_JOB_NUM_APPS, &jdata->num_apps, PMIX_UINT32);
 
     /* local size */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_SIZE, &jdata->num_local_procs, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_LOCAL_SIZE, &jdata->num_local_procs, PMIX_UINT32);
 
     /* max procs */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_MAX_PROCS, &jdata->total_slots_alloc, PMIX_UINT32);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_MAX_PROCS, &jdata->total_slots_alloc, PMIX_UINT32);
 
     /* topology signature */
-    kv = PRRTE_NEW(prrte_info_item_t);
 #if HWLOC_API_VERSION < 0x20000
-    PMIX_INFO_LOAD(&kv->info, PMIX_HWLOC_XML_V1, prrte_topo_signature, PMIX_STRING);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_HWLOC_XML_V1, prrte_topo_signature, PMIX_STRING);
 #else
-    PMIX_INFO_LOAD(&kv->info, PMIX_HWLOC_XML_V2, prrte_topo_signature, PMIX_STRING);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_HWLOC_XML_V2, prrte_topo_signature, PMIX_STRING);
 #endif
-    prrte_list_append(info, &kv->super);
 
     /* total available physical memory */
     machine = hwloc_get_next_obj_by_type (prrte_hwloc_topology, HWLOC_OBJ_MACHINE, NULL);
     if (NULL != machine) {
-        kv = PRRTE_NEW(prrte_info_item_t);
 #if HWLOC_API_VERSION < 0x20000
-        PMIX_INFO_LOAD(&kv->info, PMIX_AVAIL_PHYS_MEMORY, &machine->memory.total_memory, PMIX_UINT64);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_AVAIL_PHYS_MEMORY, &machine->memory.total_memory, PMIX_UINT64);
 #else
-        PMIX_INFO_LOAD(&kv->info, PMIX_AVAIL_PHYS_MEMORY, &machine->total_memory, PMIX_UINT64);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_AVAIL_PHYS_MEMORY, &machine->total_memory, PMIX_UINT64);
 #endif
-        prrte_list_append(info, &kv->super);
     }
 
     /* pass the mapping policy used for this job */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_MAPBY, prrte_rmaps_base_print_mapping(jdata->map->mapping), PMIX_STRING);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_MAPBY, prrte_rmaps_base_print_mapping(jdata->map->mapping), PMIX_STRING);
 
     /* pass the ranking policy used for this job */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_RANKBY, prrte_rmaps_base_print_ranking(jdata->map->ranking), PMIX_STRING);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_RANKBY, prrte_rmaps_base_print_ranking(jdata->map->ranking), PMIX_STRING);
 
     /* pass the binding policy used for this job */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_BINDTO, prrte_hwloc_base_print_binding(jdata->map->binding), PMIX_STRING);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_BINDTO, prrte_hwloc_base_print_binding(jdata->map->binding), PMIX_STRING);
 
     /* register any psets for this job */
     for (i=0; i < (int)jdata->num_apps; i++) {
@@ -319,38 +360,30 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
     }
 
     /* pass the top-level session directory - this is our jobfam session dir */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_TMPDIR, prrte_process_info.jobfam_session_dir, PMIX_STRING);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_TMPDIR, prrte_process_info.jobfam_session_dir, PMIX_STRING);
 
-    /* create and pass a job-level session directory */
-    if (0 > prrte_asprintf(&tmp, "%s/%d", prrte_process_info.jobfam_session_dir, PRRTE_LOCAL_JOBID(jdata->jobid))) {
+    /* pass a job-level session directory - it is created along
+     * with the proc-level directories of our local procs once
+     * we know what they are */
+    if (0 > prrte_asprintf(&nsdir, "%s/%d", prrte_process_info.jobfam_session_dir, PRRTE_LOCAL_JOBID(jdata->jobid))) {
         PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
         return PRRTE_ERR_OUT_OF_RESOURCE;
     }
-    if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_create(prrte_process_info.jobfam_session_dir, S_IRWXU))) {
-        PRRTE_ERROR_LOG(rc);
-        return rc;
-    }
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NSDIR, tmp, PMIX_STRING);
-    free(tmp);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_NSDIR, nsdir, PMIX_STRING);
+    procdirs = NULL;
 
     /* register any local clients */
     vpid = PRRTE_VPID_MAX;
     PRRTE_PMIX_CONVERT_JOBID(pproc.nspace, jdata->jobid);
     micro = NULL;
-    PRRTE_CONSTRUCT(&local_procs, prrte_list_t);
+    nmsize = 0;
     for (i=0; i < mynode->procs->size; i++) {
         if (NULL == (pptr = (prrte_proc_t*)prrte_pointer_array_get_item(mynode->procs, i))) {
             continue;
         }
         /* track all procs on the node */
-        nm = PRRTE_NEW(prrte_namelist_t);
-        nm->name.jobid = pptr->name.jobid;
-        nm->name.vpid = pptr->name.vpid;
-        prrte_list_append(&local_procs, &nm->super);
+        ++nmsize;
         /* see if this is a peer - i.e., from the same jobid */
         if (pptr->name.jobid == jdata->jobid) {
             prrte_argv_append_nosize(&micro, PRRTE_VPID_PRINT(pptr->name.vpid));
@@ -369,30 +402,51 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
     }
     if (NULL != micro) {
         /* pass the local peers */
-        kv = PRRTE_NEW(prrte_info_item_t);
         tmp = prrte_argv_join(micro, ',');
-        PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+        PMIX_INFO_LOAD(reg_next(&reg), PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
         free(tmp);
         prrte_argv_free(micro);
-        prrte_list_append(info, &kv->super);
     }
 
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    /* add the local procs, if they are defined */
+    if (0 < nmsize) {
+        pmix_proc_t *lprocs;
+        pinfo = reg_next(&reg);
+        PMIX_LOAD_KEY(pinfo->key, PMIX_LOCAL_PROCS);
+        pinfo->value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(pinfo->value.data.darray, nmsize, PMIX_PROC);
+        lprocs = (pmix_proc_t*)pinfo->value.data.darray->array;
+        n = 0;
+        for (i=0; i < mynode->procs->size; i++) {
+            if (NULL == (pptr = (prrte_proc_t*)prrte_pointer_array_get_item(mynode->procs, i))) {
+                continue;
+            }
+            PRRTE_PMIX_CONVERT_JOBID(lprocs[n].nspace, pptr->name.jobid);
+            PRRTE_PMIX_CONVERT_VPID(lprocs[n].rank, pptr->name.vpid);
+            ++n;
+        }
+    }
+#endif
+
     /* pass the local ldr */
-    kv = PRRTE_NEW(prrte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALLDR, &vpid, PMIX_PROC_RANK);
-    prrte_list_append(info, &kv->super);
+    PMIX_INFO_LOAD(reg_next(&reg), PMIX_LOCALLDR, &vpid, PMIX_PROC_RANK);
 
     /* for each proc in this job, create an object that
      * includes the info describing the proc so the recipient has a complete
      * picture. This allows procs to connect to each other without
      * any further info exchange, assuming the underlying transports
      * support it. We also pass all the proc-specific data here so
-     * that each proc can lookup info about every other proc in the job */
+     * that each proc can lookup info about every other proc in the job,
+     * unless compact registration was requested */
 
     for (n=0; n < map->nodes->size; n++) {
         if (NULL == (node = (prrte_node_t*)prrte_pointer_array_get_item(map->nodes, n))) {
             continue;
         }
+        if (compact && node != mynode) {
+            continue;
+        }
         /* cycle across each proc on this node, passing all data that
          * varies by proc */
         for (i=0; i < node->procs->size; i++) {
@@ -403,184 +457,134 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
             if (pptr->name.jobid != jdata->jobid) {
                 continue;
             }
-            /* setup the proc map object */
-            pmap = PRRTE_NEW(prrte_list_t);
+            /* build the proc map in scratch space, and then move
+             * it into an array of the exact size */
+            pmap = pscratch;
+            p = 0;
 
             /* must start with rank */
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_RANK, &pptr->name.vpid, PMIX_PROC_RANK);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_RANK, &pptr->name.vpid, PMIX_PROC_RANK);
 
             /* location, for local procs */
             if (node == mynode) {
                 tmp = NULL;
                 if (prrte_get_attribute(&pptr->attributes, PRRTE_PROC_CPU_BITMAP, (void**)&tmp, PRRTE_STRING) &&
                     NULL != tmp) {
-                    kv = PRRTE_NEW(prrte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, prrte_hwloc_base_get_locality_string(prrte_hwloc_topology, tmp), PMIX_STRING);
-                    prrte_list_append(pmap, &kv->super);
+                    str = prrte_hwloc_base_get_locality_string(prrte_hwloc_topology, tmp);
+                    PRRTE_PMIX_REG_PROC_LOAD(PMIX_LOCALITY_STRING, str, PMIX_STRING);
                     free(tmp);
+                    if (NULL != str) {
+                        free(str);
+                    }
                 } else {
                     /* the proc is not bound */
-                    kv = PRRTE_NEW(prrte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
-                    prrte_list_append(pmap, &kv->super);
+                    PRRTE_PMIX_REG_PROC_LOAD(PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
                 }
-                /* create and pass a proc-level session directory */
-                if (0 > prrte_asprintf(&tmp, "%s/%d/%d",
-                                       prrte_process_info.jobfam_session_dir,
-                                       PRRTE_LOCAL_JOBID(jdata->jobid), pptr->name.vpid)) {
+                /* pass a proc-level session directory, and
+                 * track it for creation */
+                if (0 > prrte_asprintf(&tmp, "%s/%d", nsdir, pptr->name.vpid)) {
                     PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                    PMIX_INFO_FREE(reg.info, reg.ninfo);
+                    prrte_argv_free(procdirs);
+                    free(nsdir);
                     return PRRTE_ERR_OUT_OF_RESOURCE;
                 }
-                if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_create(tmp, S_IRWXU))) {
-                    PRRTE_ERROR_LOG(rc);
-                    return rc;
-                }
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_PROCDIR, tmp, PMIX_STRING);
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_PROCDIR, tmp, PMIX_STRING);
+                prrte_argv_append_nosize(&procdirs, tmp + strlen(nsdir) + 1);
                 free(tmp);
-                prrte_list_append(pmap, &kv->super);
             }
 
             /* global/univ rank */
-            kv = PRRTE_NEW(prrte_info_item_t);
             vpid = pptr->name.vpid + jdata->offset;
-            PMIX_INFO_LOAD(&kv->info, PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
 
             if (1 < jdata->num_apps) {
                 /* appnum */
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
-                prrte_list_append(pmap, &kv->super);
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
 
                 /* app ldr */
                 app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, pptr->app_idx);
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_APPLDR, &app->first_rank, PMIX_PROC_RANK);
-                prrte_list_append(pmap, &kv->super);
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_APPLDR, &app->first_rank, PMIX_PROC_RANK);
 
                 /* app rank */
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
-                prrte_list_append(pmap, &kv->super);
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
 
                 /* app size */
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_APP_SIZE, &app->num_procs, PMIX_UINT32);
-                prrte_list_append(info, &kv->super);
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_APP_SIZE, &app->num_procs, PMIX_UINT32);
 
 #if PMIX_NUMERIC_VERSION >= 0x00040000
-                app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, pptr->app_idx);
                 tmp = NULL;
                 if (prrte_get_attribute(&app->attributes, PRRTE_APP_PSET_NAME, (void**)&tmp, PRRTE_STRING) &&
                     NULL != tmp) {
-                    kv = PRRTE_NEW(prrte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_PSET_NAME, tmp, PMIX_STRING);
+                    PRRTE_PMIX_REG_PROC_LOAD(PMIX_PSET_NAME, tmp, PMIX_STRING);
                     free(tmp);
-                    prrte_list_append(pmap, &kv->super);
                 }
             } else {
                 app = (prrte_app_context_t*)prrte_pointer_array_get_item(jdata->apps, 0);
                 tmp = NULL;
                 if (prrte_get_attribute(&app->attributes, PRRTE_APP_PSET_NAME, (void**)&tmp, PRRTE_STRING) &&
                     NULL != tmp) {
-                    kv = PRRTE_NEW(prrte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_PSET_NAME, tmp, PMIX_STRING);
+                    PRRTE_PMIX_REG_PROC_LOAD(PMIX_PSET_NAME, tmp, PMIX_STRING);
                     free(tmp);
-                    prrte_list_append(pmap, &kv->super);
                 }
 #endif
             }
 
             /* local rank */
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
 
             /* node rank */
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
 
             /* node ID */
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
 
 #if PMIX_NUMERIC_VERSION >= 0x00040000
             /* reincarnation number */
             ui32 = 0;  // we are starting this proc for the first time
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_REINCARNATION, &ui32, PMIX_UINT32);
-            prrte_list_append(pmap, &kv->super);
+            PRRTE_PMIX_REG_PROC_LOAD(PMIX_REINCARNATION, &ui32, PMIX_UINT32);
 #endif
 
             if (map->num_nodes < prrte_hostname_cutoff) {
-                kv = PRRTE_NEW(prrte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
-                prrte_list_append(pmap, &kv->super);
-            }
-            kv = PRRTE_NEW(prrte_info_item_t);
-            PMIX_LOAD_KEY(kv->info.key, PMIX_PROC_DATA);
-            kv->info.value.type = PMIX_DATA_ARRAY;
-            ninfo = prrte_list_get_size(pmap);
-            if (0 < ninfo) {
-                PMIX_DATA_ARRAY_CREATE(kv->info.value.data.darray, ninfo, PMIX_INFO);
-                pinfo = (pmix_info_t*)kv->info.value.data.darray->array;
-                p = 0;
-                while (NULL != (kptr = (prrte_info_item_t*)prrte_list_remove_first(pmap))) {
-                    PMIX_INFO_XFER(&pinfo[p], &kptr->info);
-                    PRRTE_RELEASE(kptr);
-                    ++p;
-                }
+                PRRTE_PMIX_REG_PROC_LOAD(PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
             }
-            prrte_list_append(info, &kv->super);
+            /* the scratch values are moved, not copied, so
+             * there is nothing left to release there */
+            pinfo = reg_next(&reg);
+            PMIX_LOAD_KEY(pinfo->key, PMIX_PROC_DATA);
+            pinfo->value.type = PMIX_DATA_ARRAY;
+            PMIX_DATA_ARRAY_CREATE(pinfo->value.data.darray, p, PMIX_INFO);
+            memcpy(pinfo->value.data.darray->array, pmap, p * sizeof(pmix_info_t));
         }
     }
 
-    /* mark the job as registered */
-    prrte_set_attribute(&jdata->attributes, PRRTE_JOB_NSPACE_REGISTERED, PRRTE_ATTR_LOCAL, NULL, PRRTE_BOOL);
-
-    /* pass it down */
-    ninfo = prrte_list_get_size(info);
-    /* if there are local procs, then we add that here */
-    if (0 < (nmsize = prrte_list_get_size(&local_procs))) {
-        ++ninfo;
+    PMIX_INFO_DESTRUCT(&reg.sink);
+    if (reg.failed) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
+        prrte_argv_free(procdirs);
+        free(nsdir);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
     }
-    PMIX_INFO_CREATE(pinfo, ninfo);
 
-#if PMIX_NUMERIC_VERSION >= 0x00040000
-    /* first add the local procs, if they are defined */
-    if (0 < nmsize) {
-        pmix_proc_t *procs;
-        PMIX_LOAD_KEY(pinfo[0].key, PMIX_LOCAL_PROCS);
-        pinfo[0].value.type = PMIX_DATA_ARRAY;
-        PMIX_DATA_ARRAY_CREATE(pinfo[0].value.data.darray, nmsize, PMIX_PROC);
-        procs = (pmix_proc_t*)pinfo[0].value.data.darray->array;
-        n = 0;
-        PRRTE_LIST_FOREACH(nm, &local_procs, prrte_namelist_t) {
-            PRRTE_PMIX_CONVERT_JOBID(procs[n].nspace, nm->name.jobid);
-            PRRTE_PMIX_CONVERT_VPID(procs[n].rank, nm->name.vpid);
-            ++n;
-        }
+    /* create the session directories in one batch, relative to
+     * the job-level directory - they must exist before the procs
+     * are started, which cannot happen before we return */
+    rc = prrte_os_dirpath_create_batch(nsdir, procdirs, S_IRWXU);
+    prrte_argv_free(procdirs);
+    free(nsdir);
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_ERROR_LOG(rc);
+        PMIX_INFO_FREE(reg.info, reg.ninfo);
+        return rc;
     }
-#endif
 
-    PRRTE_LIST_DESTRUCT(&local_procs);
+    /* mark the job as registered */
+    prrte_set_attribute(&jdata->attributes, PRRTE_JOB_NSPACE_REGISTERED, PRRTE_ATTR_LOCAL, NULL, PRRTE_BOOL);
 
-    /* now load the rest of the list */
-    if (0 < nmsize) {
-        n = 1;
-    } else {
-        n = 0;
-    }
-    PRRTE_LIST_FOREACH(kv, info, prrte_info_item_t) {
-        PMIX_INFO_XFER(&pinfo[n], &kv->info);
-        ++n;
-    }
-    PRRTE_LIST_RELEASE(info);
+    /* pass it down */
+    pinfo = reg.info;
+    ninfo = reg.ninfo;
 
     /* register it */
     PRRTE_PMIX_CONSTRUCT_LOCK(&lock);
@@ -591,7 +595,6 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
         PMIX_ERROR_LOG(ret);
         rc = prrte_pmix_convert_status(ret);
         PMIX_INFO_FREE(pinfo, ninfo);
-        PRRTE_LIST_RELEASE(info);
         PRRTE_PMIX_DESTRUCT_LOCK(&lock);
         return rc;
     }
@@ -664,7 +667,6 @@ int prrte_pmix_server_register_nspace(prrte_job_t *jdata)
             PMIX_ERROR_LOG(ret);
             rc = prrte_pmix_convert_status(ret);
             PMIX_INFO_FREE(pinfo, ninfo);
-            PRRTE_LIST_RELEASE(info);
             PRRTE_PMIX_DESTRUCT_LOCK(&lock);
             return rc;
         }
@@ -624,7 +624,8 @@ void prrte_daemon_recv(int status, prrte_process_name_t* sender,
             ret = PRRTE_ERR_OUT_OF_RESOURCE;
             goto CLEANUP;
         }
-        prrte_os_dirpath_destroy(cmd_str, true, NULL);
+        prrte_os_dirpath_destroy_parallel(cmd_str, true, NULL,
+                                         prrte_session_dir_cleanup_threads);
         free(cmd_str);
         cmd_str = NULL;
         PRRTE_RELEASE(jdata);
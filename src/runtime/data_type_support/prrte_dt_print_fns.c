@@ -475,15 +475,17 @@ int prrte_dt_print_proc(char **output, char *prefix, prrte_proc_t *src, prrte_da
     if (!prrte_devel_level_output) {
         if (prrte_get_attribute(&src->attributes, PRRTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, PRRTE_STRING) &&
             NULL != src->node->topology && NULL != src->node->topology->topo) {
-            mycpus = hwloc_bitmap_alloc();
-            hwloc_bitmap_list_sscanf(mycpus, cpu_bitmap);
-            if (PRRTE_ERR_NOT_BOUND == prrte_hwloc_base_cset2str(tmp1, sizeof(tmp1), src->node->topology->topo, mycpus)) {
+            if (NULL == (mycpus = prrte_hwloc_base_get_cpuset(src->node->topology->topo, cpu_bitmap))) {
+                str = strdup("UNKNOWN");
+            } else if (PRRTE_ERR_NOT_BOUND == prrte_hwloc_base_cset2str(tmp1, sizeof(tmp1), src->node->topology->topo, mycpus)) {
                 str = strdup("UNBOUND");
             } else {
                 prrte_hwloc_base_cset2mapstr(tmp2, sizeof(tmp2), src->node->topology->topo, mycpus);
                 prrte_asprintf(&str, "%s:%s", tmp1, tmp2);
             }
-            hwloc_bitmap_free(mycpus);
+            if (NULL != mycpus) {
+                hwloc_bitmap_free(mycpus);
+            }
             prrte_asprintf(&tmp, "\n%sProcess OMPI jobid: %s App: %ld Process rank: %s Bound: %s", pfx2,
                      PRRTE_JOBID_PRINT(src->name.jobid), (long)src->app_idx,
                      PRRTE_VPID_PRINT(src->name.vpid), (NULL == str) ? "N/A" : str);
@@ -526,9 +528,12 @@ int prrte_dt_print_proc(char **output, char *prefix, prrte_proc_t *src, prrte_da
     }
     if (prrte_get_attribute(&src->attributes, PRRTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, PRRTE_STRING) &&
         NULL != src->node->topology && NULL != src->node->topology->topo) {
-        mycpus = hwloc_bitmap_alloc();
-        hwloc_bitmap_list_sscanf(mycpus, cpu_bitmap);
-        prrte_hwloc_base_cset2mapstr(tmp2, sizeof(tmp2), src->node->topology->topo, mycpus);
+        if (NULL == (mycpus = prrte_hwloc_base_get_cpuset(src->node->topology->topo, cpu_bitmap))) {
+            snprintf(tmp2, sizeof(tmp2), "UNKNOWN");
+        } else {
+            prrte_hwloc_base_cset2mapstr(tmp2, sizeof(tmp2), src->node->topology->topo, mycpus);
+            hwloc_bitmap_free(mycpus);
+        }
     } else {
         snprintf(tmp2, sizeof(tmp2), "UNBOUND");
     }
@@ -35,6 +35,7 @@
 #include "src/util/argv.h"
 #include "src/util/output.h"
 #include "src/class/prrte_pointer_array.h"
+#include "src/class/prrte_hash_table.h"
 #include "src/dss/dss.h"
 #include "src/pmix/pmix-internal.h"
 
@@ -66,7 +67,8 @@ typedef struct {
     /* and the values themselves */
     pmix_info_t *info;
     size_t ninfo;
-    /* the value itself */
+    /* index entries for each of the values */
+    struct prrte_data_ref_t **refs;
 } prrte_data_object_t;
 
 static void construct(prrte_data_object_t *ptr)
@@ -78,6 +80,7 @@ static void construct(prrte_data_object_t *ptr)
     ptr->persistence = PMIX_PERSIST_SESSION;
     ptr->info = NULL;
     ptr->ninfo = 0;
+    ptr->refs = NULL;
 }
 
 static void destruct(prrte_data_object_t *ptr)
@@ -85,6 +88,9 @@ static void destruct(prrte_data_object_t *ptr)
     if (NULL != ptr->info) {
         PMIX_INFO_FREE(ptr->info, ptr->ninfo);
     }
+    if (NULL != ptr->refs) {
+        free(ptr->refs);
+    }
 }
 
 static PRRTE_CLASS_INSTANCE(prrte_data_object_t,
@@ -101,28 +107,334 @@ typedef struct {
     pmix_data_range_t range;
     char **keys;
     prrte_list_t answers;
+    /* our entry on the waiters list of each key */
+    struct prrte_data_waiter_t **waiters;
+    bool woken;
 } prrte_data_req_t;
 static void rqcon(prrte_data_req_t *p)
 {
     p->keys = NULL;
     PRRTE_CONSTRUCT(&p->answers, prrte_list_t);
+    p->waiters = NULL;
+    p->woken = false;
 }
 static void rqdes(prrte_data_req_t *p)
 {
     prrte_argv_free(p->keys);
     PRRTE_LIST_DESTRUCT(&p->answers);
+    if (NULL != p->waiters) {
+        free(p->waiters);
+    }
 }
 static PRRTE_CLASS_INSTANCE(prrte_data_req_t,
                           prrte_list_item_t,
                           rqcon, rqdes);
 
+/* define the index entry for a given (uid, key) - it tracks
+ * every stored value published under that key plus the
+ * lookups that are waiting for it to appear */
+typedef struct {
+    prrte_object_t super;
+    /* the hash key */
+    char *hkey;
+    size_t hkeylen;
+    /* prrte_data_ref_t for each stored value */
+    prrte_list_t refs;
+    /* prrte_data_waiter_t for each pending lookup */
+    prrte_list_t waiters;
+} prrte_data_key_t;
+static void dkcon(prrte_data_key_t *p)
+{
+    p->hkey = NULL;
+    p->hkeylen = 0;
+    PRRTE_CONSTRUCT(&p->refs, prrte_list_t);
+    PRRTE_CONSTRUCT(&p->waiters, prrte_list_t);
+}
+static void dkdes(prrte_data_key_t *p)
+{
+    if (NULL != p->hkey) {
+        free(p->hkey);
+    }
+    PRRTE_LIST_DESTRUCT(&p->refs);
+    PRRTE_LIST_DESTRUCT(&p->waiters);
+}
+static PRRTE_CLASS_INSTANCE(prrte_data_key_t,
+                          prrte_object_t,
+                          dkcon, dkdes);
+
+/* link a stored value to the index entry for its key */
+typedef struct prrte_data_ref_t {
+    prrte_list_item_t super;
+    prrte_data_key_t *dkey;
+    prrte_data_object_t *data;
+    size_t n;
+} prrte_data_ref_t;
+static PRRTE_CLASS_INSTANCE(prrte_data_ref_t,
+                          prrte_list_item_t,
+                          NULL, NULL);
+
+/* link a pending lookup to the index entry of a key it wants */
+typedef struct prrte_data_waiter_t {
+    prrte_list_item_t super;
+    prrte_data_key_t *dkey;
+    prrte_data_req_t *req;
+} prrte_data_waiter_t;
+static PRRTE_CLASS_INSTANCE(prrte_data_waiter_t,
+                          prrte_list_item_t,
+                          NULL, NULL);
+
 /* local globals */
 static prrte_pointer_array_t prrte_data_server_store;
+static prrte_hash_table_t prrte_data_server_index;
 static prrte_list_t pending;
 static bool initialized = false;
 static int prrte_data_server_output = -1;
 static int prrte_data_server_verbosity = -1;
 
+/* lookups are restricted to data posted by the same user id,
+ * so fold the uid into the index key */
+static prrte_data_key_t* get_key(uint32_t uid, const char *key, bool create)
+{
+    char hkey[sizeof(uint32_t) + PMIX_MAX_KEYLEN + 1];
+    size_t len;
+    prrte_data_key_t *dkey = NULL;
+
+    len = strlen(key);
+    if (PMIX_MAX_KEYLEN < len) {
+        len = PMIX_MAX_KEYLEN;
+    }
+    memcpy(hkey, &uid, sizeof(uint32_t));
+    memcpy(hkey + sizeof(uint32_t), key, len);
+    len += sizeof(uint32_t);
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_data_server_index,
+                                                        hkey, len, (void**)&dkey)) {
+        return dkey;
+    }
+    if (!create) {
+        return NULL;
+    }
+    dkey = PRRTE_NEW(prrte_data_key_t);
+    dkey->hkey = (char*)malloc(len);
+    memcpy(dkey->hkey, hkey, len);
+    dkey->hkeylen = len;
+    prrte_hash_table_set_value_ptr(&prrte_data_server_index, hkey, len, dkey);
+    return dkey;
+}
+
+/* drop an index entry once nothing is stored or awaited under it */
+static void prune_key(prrte_data_key_t *dkey)
+{
+    if (prrte_list_is_empty(&dkey->refs) &&
+        prrte_list_is_empty(&dkey->waiters)) {
+        prrte_hash_table_remove_value_ptr(&prrte_data_server_index,
+                                          dkey->hkey, dkey->hkeylen);
+        PRRTE_RELEASE(dkey);
+    }
+}
+
+static void index_data(prrte_data_object_t *data)
+{
+    prrte_data_ref_t *ref;
+    size_t n;
+
+    data->refs = (prrte_data_ref_t**)calloc(data->ninfo, sizeof(prrte_data_ref_t*));
+    for (n=0; n < data->ninfo; n++) {
+        ref = PRRTE_NEW(prrte_data_ref_t);
+        ref->dkey = get_key(data->uid, data->info[n].key, true);
+        ref->data = data;
+        ref->n = n;
+        prrte_list_append(&ref->dkey->refs, &ref->super);
+        data->refs[n] = ref;
+    }
+}
+
+/* remove a value from the index and blank its key so it
+ * is no longer visible - the caller is responsible for
+ * pruning the index entry */
+static void unindex_value(prrte_data_ref_t *ref)
+{
+    prrte_list_remove_item(&ref->dkey->refs, &ref->super);
+    ref->data->refs[ref->n] = NULL;
+    memset(ref->data->info[ref->n].key, 0, PMIX_MAX_KEYLEN+1);
+    PRRTE_RELEASE(ref);
+}
+
+static void remove_data(prrte_data_object_t *data)
+{
+    prrte_data_key_t *dkey;
+    size_t n;
+
+    for (n=0; n < data->ninfo; n++) {
+        if (NULL != data->refs[n]) {
+            dkey = data->refs[n]->dkey;
+            unindex_value(data->refs[n]);
+            prune_key(dkey);
+        }
+    }
+    prrte_pointer_array_set_item(&prrte_data_server_store, data->index, NULL);
+    PRRTE_RELEASE(data);
+}
+
+/* if the published range is constrained to namespace, then only
+ * consider the data if the publisher is in the same namespace
+ * as the requestor */
+static bool data_visible(prrte_data_object_t *data, pmix_proc_t *requestor)
+{
+    if (PMIX_RANGE_NAMESPACE == data->range &&
+        0 != strncmp(requestor->nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+        return false;
+    }
+    return true;
+}
+
+/* a pending lookup has been answered - take it off the
+ * waiters list of every key it was waiting on */
+static void retire_req(prrte_data_req_t *req)
+{
+    prrte_data_waiter_t *w;
+    int i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL != (w = req->waiters[i])) {
+            prrte_list_remove_item(&w->dkey->waiters, &w->super);
+            prune_key(w->dkey);
+            PRRTE_RELEASE(w);
+        }
+    }
+    prrte_list_remove_item(&pending, &req->super);
+    PRRTE_RELEASE(req);
+}
+
+static int answer_req(prrte_data_req_t *req, prrte_data_object_t *data,
+                      pmix_proc_t *psender)
+{
+    prrte_buffer_t *reply;
+    prrte_ds_info_t *rinfo;
+    pmix_data_buffer_t pbkt;
+    pmix_byte_object_t pbo;
+    prrte_byte_object_t bo, *boptr;
+    pmix_status_t ret;
+    uint8_t command;
+    size_t n, m;
+    int rc, i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        /* cycle thru the data keys for matches */
+        for (m=0; m < data->ninfo; m++) {
+            prrte_output_verbose(10, prrte_data_server_output,
+                                "%s\tCHECKING %s TO %s",
+                                PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                data->info[m].key, req->keys[i]);
+            if (0 == strncmp(data->info[m].key, req->keys[i], PMIX_MAX_KEYLEN)) {
+                /* track this response */
+                prrte_output_verbose(10, prrte_data_server_output,
+                                    "%s data server: adding %s data %s from %s:%d to response",
+                                    PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[m].key,
+                                    PMIx_Data_type_string(data->info[m].value.type),
+                                    data->owner.nspace, data->owner.rank);
+                rinfo = PRRTE_NEW(prrte_ds_info_t);
+                memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
+                rinfo->info = &data->info[m];
+                prrte_list_append(&req->answers, &rinfo->super);
+                break;  // a key can only occur once
+            }
+        }
+    }
+    if (0 == (n = prrte_list_get_size(&req->answers))) {
+        return PRRTE_ERR_NOT_FOUND;
+    }
+
+    /* send it back to the requestor */
+    prrte_output_verbose(1, prrte_data_server_output,
+                         "%s data server: returning data to %s:%d",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         req->requestor.nspace, req->requestor.rank);
+
+    reply = PRRTE_NEW(prrte_buffer_t);
+    /* start with their room number */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &req->room_number, 1, PRRTE_INT))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    /* we are responding to a lookup cmd */
+    command = PRRTE_PMIX_LOOKUP_CMD;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &command, 1, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    /* if we found all of the requested keys, then indicate so */
+    if (n == (size_t)prrte_argv_count(req->keys)) {
+        i = PRRTE_SUCCESS;
+    } else {
+        i = PRRTE_ERR_PARTIAL_SUCCESS;
+    }
+    /* return the status */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &i, 1, PRRTE_INT))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+
+    /* pack the rest into a pmix_data_buffer_t */
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+
+    /* pack the number of returned info's */
+    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, &n, 1, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        PRRTE_RELEASE(reply);
+        return PRRTE_ERR_PACK_FAILURE;
+    }
+    /* loop thru and pack the individual responses - this is somewhat less
+     * efficient than packing an info array, but avoids another malloc
+     * operation just to assemble all the return values into a contiguous
+     * array */
+    while (NULL != (rinfo = (prrte_ds_info_t*)prrte_list_remove_first(&req->answers))) {
+        /* pack the data owner */
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
+            PMIX_ERROR_LOG(ret);
+            PRRTE_RELEASE(rinfo);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            PRRTE_RELEASE(reply);
+            return PRRTE_ERR_PACK_FAILURE;
+        }
+        /* pack the data */
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, rinfo->info, 1, PMIX_INFO))) {
+            PMIX_ERROR_LOG(ret);
+            PRRTE_RELEASE(rinfo);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            PRRTE_RELEASE(reply);
+            return PRRTE_ERR_PACK_FAILURE;
+        }
+        PRRTE_RELEASE(rinfo);
+    }
+
+    /* unload the pmix buffer */
+    PMIX_DATA_BUFFER_UNLOAD(&pbkt, pbo.bytes, pbo.size);
+    bo.bytes = (uint8_t*)pbo.bytes;
+    bo.size = pbo.size;
+
+    /* pack it into our reply */
+    boptr = &bo;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &boptr, 1, PRRTE_BYTE_OBJECT))) {
+        PRRTE_ERROR_LOG(rc);
+        free(bo.bytes);
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    free(bo.bytes);
+    if (0 > (rc = prrte_rml.send_buffer_nb(&req->proxy, reply, PRRTE_RML_TAG_DATA_CLIENT,
+                                          prrte_rml_send_callback, NULL))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    return PRRTE_SUCCESS;
+}
+
 int prrte_data_server_init(void)
 {
     int rc;
@@ -154,6 +466,9 @@ int prrte_data_server_init(void)
         return rc;
     }
 
+    PRRTE_CONSTRUCT(&prrte_data_server_index, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_data_server_index, 256);
+
     PRRTE_CONSTRUCT(&pending, prrte_list_t);
 
     prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD,
@@ -169,6 +484,10 @@ void prrte_data_server_finalize(void)
 {
     prrte_std_cntr_t i;
     prrte_data_object_t *data;
+    prrte_data_key_t *dkey;
+    void *key, *node, *next;
+    size_t keylen;
+    int rc;
 
     if (!initialized) {
         return;
@@ -181,6 +500,16 @@ void prrte_data_server_finalize(void)
         }
     }
     PRRTE_DESTRUCT(&prrte_data_server_store);
+
+    rc = prrte_hash_table_get_first_key_ptr(&prrte_data_server_index, &key, &keylen,
+                                            (void**)&dkey, &node);
+    while (PRRTE_SUCCESS == rc) {
+        PRRTE_RELEASE(dkey);
+        rc = prrte_hash_table_get_next_key_ptr(&prrte_data_server_index, &key, &keylen,
+                                               (void**)&dkey, node, &next);
+        node = next;
+    }
+    PRRTE_DESTRUCT(&prrte_data_server_index);
     PRRTE_LIST_DESTRUCT(&pending);
 }
 
@@ -200,7 +529,11 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
     int room_number;
     uint32_t uid = UINT32_MAX;
     pmix_data_range_t range;
-    prrte_data_req_t *req, *rqnext;
+    prrte_data_req_t *req;
+    prrte_data_key_t *dkey;
+    prrte_data_ref_t *ref, *rnext;
+    prrte_data_waiter_t *w;
+    prrte_pointer_array_t woken;
     pmix_data_buffer_t pbkt;
     pmix_byte_object_t pbo;
     pmix_status_t ret;
@@ -324,134 +657,34 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
 
         /* store this object */
         data->index = prrte_pointer_array_add(&prrte_data_server_store, data);
+        index_data(data);
 
         prrte_output_verbose(1, prrte_data_server_output,
                             "%s data server: checking for pending requests",
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
 
-        /* check for pending requests that match this data */
-        reply = NULL;
-        PRRTE_LIST_FOREACH_SAFE(req, rqnext, &pending, prrte_data_req_t) {
-            if (req->uid != data->uid) {
-                continue;
-            }
-            /* if the published range is constrained to namespace, then only
-             * consider this data if the publisher is
-             * in the same namespace as the requestor */
-            if (PMIX_RANGE_NAMESPACE == data->range) {
-                if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+        /* wake the pending requests waiting on any of these keys - a
+         * request may be waiting on several of them, so collect each
+         * one only once before answering */
+        PRRTE_CONSTRUCT(&woken, prrte_pointer_array_t);
+        prrte_pointer_array_init(&woken, 1, INT_MAX, 8);
+        for (n=0; n < data->ninfo; n++) {
+            PRRTE_LIST_FOREACH(w, &data->refs[n]->dkey->waiters, prrte_data_waiter_t) {
+                if (w->req->woken || !data_visible(data, &w->req->requestor)) {
                     continue;
                 }
+                w->req->woken = true;
+                prrte_pointer_array_add(&woken, w->req);
             }
-            for (i=0; NULL != req->keys[i]; i++) {
-                /* cycle thru the data keys for matches */
-                for (n=0; n < data->ninfo; n++) {
-                    prrte_output_verbose(10, prrte_data_server_output,
-                                        "%s\tCHECKING %s TO %s",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        data->info[n].key, req->keys[i]);
-                    if (0 == strncmp(data->info[n].key, req->keys[i], PMIX_MAX_KEYLEN)) {
-                        prrte_output_verbose(10, prrte_data_server_output,
-                                            "%s data server: packaging return",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
-                        /* track this response */
-                        prrte_output_verbose(10, prrte_data_server_output,
-                                            "%s data server: adding %s data %s from %s:%d to response",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[n].key,
-                                            PMIx_Data_type_string(data->info[n].value.type),
-                                            data->owner.nspace, data->owner.rank);
-                        rinfo = PRRTE_NEW(prrte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        prrte_list_append(&req->answers, &rinfo->super);
-                        break;  // a key can only occur once
-                    }
-                }
-            }
-            if (0 < (n = prrte_list_get_size(&req->answers))) {
-                /* send it back to the requestor */
-                prrte_output_verbose(1, prrte_data_server_output,
-                                     "%s data server: returning data to %s:%d",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     req->requestor.nspace, req->requestor.rank);
-
-                reply = PRRTE_NEW(prrte_buffer_t);
-                /* start with their room number */
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &req->room_number, 1, PRRTE_INT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* we are responding to a lookup cmd */
-                command = PRRTE_PMIX_LOOKUP_CMD;
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &command, 1, PRRTE_UINT8))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* if we found all of the requested keys, then indicate so */
-                if (n == (size_t)prrte_argv_count(req->keys)) {
-                    i = PRRTE_SUCCESS;
-                } else {
-                    i = PRRTE_ERR_PARTIAL_SUCCESS;
-                }
-                /* return the status */
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &i, 1, PRRTE_INT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-
-                /* pack the rest into a pmix_data_buffer_t */
-                PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-
-                /* pack the number of returned info's */
-                if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, &n, 1, PMIX_SIZE))) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                    rc = PRRTE_ERR_PACK_FAILURE;
-                    goto SEND_ERROR;
-                }
-                /* loop thru and pack the individual responses - this is somewhat less
-                 * efficient than packing an info array, but avoids another malloc
-                 * operation just to assemble all the return values into a contiguous
-                 * array */
-                while (NULL != (rinfo = (prrte_ds_info_t*)prrte_list_remove_first(&req->answers))) {
-                    /* pack the data owner */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
-                    }
-                    /* pack the data */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, rinfo->info, 1, PMIX_INFO))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
-                    }
-                }
-                PRRTE_LIST_DESTRUCT(&req->answers);
-                PRRTE_CONSTRUCT(&req->answers, prrte_list_t);
-
-                /* unload the pmix buffer */
-                PMIX_DATA_BUFFER_UNLOAD(&pbkt, pbo.bytes, pbo.size);
-                bo.bytes = (uint8_t*)pbo.bytes;
-                bo.size = pbo.size;
-
-                /* pack it into our reply */
-                boptr = &bo;
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &boptr, 1, PRRTE_BYTE_OBJECT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    free(bo.bytes);
-                    goto SEND_ERROR;
-                }
-                free(bo.bytes);
-                if (0 > (rc = prrte_rml.send_buffer_nb(&req->proxy, reply, PRRTE_RML_TAG_DATA_CLIENT,
-                                                      prrte_rml_send_callback, NULL))) {
-                    PRRTE_ERROR_LOG(rc);
-                    PRRTE_RELEASE(reply);
-                }
+        }
+        for (k=0; k < woken.size; k++) {
+            if (NULL == (req = (prrte_data_req_t*)prrte_pointer_array_get_item(&woken, k))) {
+                continue;
             }
+            answer_req(req, data, &psender);
+            retire_req(req);
         }
+        PRRTE_DESTRUCT(&woken);
 
         /* tell the user it was wonderful... */
         rc = PRRTE_SUCCESS;
@@ -550,50 +783,29 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
             prrte_output_verbose(10, prrte_data_server_output,
                                 "%s data server: looking for %s",
                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), keys[i]);
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prrte_data_server_store.size; k++) {
-                data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* for security reasons, can only access data posted by the same user id */
-                if (uid != data->uid) {
+            /* for security reasons, can only access data posted by the
+             * same user id - the uid is part of the index key */
+            if (NULL == (dkey = get_key(uid, keys[i], false))) {
+                continue;
+            }
+            PRRTE_LIST_FOREACH(ref, &dkey->refs, prrte_data_ref_t) {
+                data = ref->data;
+                if (!data_visible(data, &requestor)) {
                     prrte_output_verbose(10, prrte_data_server_output,
-                                        "%s\tMISMATCH UID %u %u",
+                                        "%s\tMISMATCH NSPACES %s %s",
                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        (unsigned)uid, (unsigned)data->uid);
+                                        requestor.nspace, data->owner.nspace);
                     continue;
                 }
-                /* if the published range is constrained to namespace, then only
-                 * consider this data if the publisher is
-                 * in the same namespace as the requestor */
-                if (PMIX_RANGE_NAMESPACE == data->range) {
-                    if (0 != strncmp(requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
-                        prrte_output_verbose(10, prrte_data_server_output,
-                                            "%s\tMISMATCH NSPACES %s %s",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                            requestor.nspace, data->owner.nspace);
-                        continue;
-                    }
-                }
-                /* see if we have this key */
-                for (n=0; n < data->ninfo; n++) {
-                    prrte_output_verbose(10, prrte_data_server_output,
-                                        "%s COMPARING %s %s",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        keys[i], data->info[n].key);
-                    if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        rinfo = PRRTE_NEW(prrte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        rinfo->persistence = data->persistence;
-                        prrte_list_append(&answers, &rinfo->super);
-                        prrte_output_verbose(1, prrte_data_server_output,
-                                            "%s data server: adding %s to data from %s:%d",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[n].key,
-                                            data->owner.nspace, data->owner.rank);
-                    }
-                }
+                rinfo = PRRTE_NEW(prrte_ds_info_t);
+                memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
+                rinfo->info = &data->info[ref->n];
+                rinfo->persistence = data->persistence;
+                prrte_list_append(&answers, &rinfo->super);
+                prrte_output_verbose(1, prrte_data_server_output,
+                                    "%s data server: adding %s to data from %s:%d",
+                                    PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[ref->n].key,
+                                    data->owner.nspace, data->owner.rank);
             }  // loop over stored data
         }  // loop over keys
 
@@ -626,14 +838,26 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                     prrte_argv_free(keys);
                     goto SEND_ERROR;
                 }
-                if (PMIX_PERSIST_FIRST_READ == rinfo->persistence) {
+            }
+            /* remove anything that was only to be read once */
+            for (i=0; NULL != keys[i]; i++) {
+                if (NULL == (dkey = get_key(uid, keys[i], false))) {
+                    continue;
+                }
+                PRRTE_LIST_FOREACH_SAFE(ref, rnext, &dkey->refs, prrte_data_ref_t) {
+                    data = ref->data;
+                    if (PMIX_PERSIST_FIRST_READ != data->persistence ||
+                        !data_visible(data, &requestor)) {
+                        continue;
+                    }
                     prrte_output_verbose(1, prrte_data_server_output,
                                         "%s REMOVING DATA FROM %s:%d FOR KEY %s",
                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        rinfo->source.nspace, rinfo->source.rank,
-                                        rinfo->info->key);
-                    memset(rinfo->info->key, 0, PMIX_MAX_KEYLEN+1);
+                                        data->owner.nspace, data->owner.rank,
+                                        data->info[ref->n].key);
+                    unindex_value(ref);
                 }
+                prune_key(dkey);
             }
         }
         PRRTE_LIST_DESTRUCT(&answers);
@@ -659,6 +883,17 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 req->uid = uid;
                 req->range = range;
                 req->keys = keys;
+                /* register on the waiters list of each key so we are woken
+                 * as soon as any of them is published */
+                req->waiters = (prrte_data_waiter_t**)calloc(prrte_argv_count(keys),
+                                                             sizeof(prrte_data_waiter_t*));
+                for (i=0; NULL != keys[i]; i++) {
+                    w = PRRTE_NEW(prrte_data_waiter_t);
+                    w->dkey = get_key(uid, keys[i], true);
+                    w->req = req;
+                    prrte_list_append(&w->dkey->waiters, &w->super);
+                    req->waiters[i] = w;
+                }
                 prrte_list_append(&pending, &req->super);
                 /* drop the partial response we have - we'll build it when everything
                  * becomes available */
@@ -783,16 +1018,12 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
 
         /* cycle across the provided keys */
         for (i=0; NULL != keys[i]; i++) {
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prrte_data_server_store.size; k++) {
-                data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* can only access data posted by the same user id */
-                if (uid != data->uid) {
-                    continue;
-                }
+            /* can only access data posted by the same user id */
+            if (NULL == (dkey = get_key(uid, keys[i], false))) {
+                continue;
+            }
+            PRRTE_LIST_FOREACH_SAFE(ref, rnext, &dkey->refs, prrte_data_ref_t) {
+                data = ref->data;
                 /* can only access data posted by the same process */
                 if (0 != strncmp(requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN) ||
                     requestor.rank != data->owner.rank) {
@@ -802,25 +1033,20 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 if (range != data->range) {
                     continue;
                 }
-                /* see if we have this key */
+                /* found it -  delete the value from the data store */
+                unindex_value(ref);
+                /* if all the data has been removed, then remove the object */
                 nanswers = 0;
                 for (n=0; n < data->ninfo; n++) {
-                    if (0 == strlen(data->info[n].key)) {
-                        ++nanswers;
-                        continue;
-                    }
-                    if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        /* found it -  delete the object from the data store */
-                        memset(data->info[n].key, 0, PMIX_MAX_KEYLEN+1);
+                    if (NULL == data->refs[n]) {
                         ++nanswers;
                     }
                 }
-                /* if all the data has been removed, then remove the object */
                 if (nanswers == data->ninfo) {
-                    prrte_pointer_array_set_item(&prrte_data_server_store, k, NULL);
-                    PRRTE_RELEASE(data);
+                    remove_data(data);
                 }
             }
+            prune_key(dkey);
         }
         prrte_argv_free(keys);
 
@@ -869,8 +1095,7 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 continue;
             }
             /* remove the object */
-            prrte_pointer_array_set_item(&prrte_data_server_store, k, NULL);
-            PRRTE_RELEASE(data);
+            remove_data(data);
         }
         /* no response is required */
         PRRTE_RELEASE(answer);
@@ -129,6 +129,10 @@ prrte_pointer_array_t *prrte_node_topologies = NULL;
 prrte_pointer_array_t *prrte_local_children = NULL;
 prrte_vpid_t prrte_total_procs = 0;
 
+/* hashed index of node names and aliases into the node pool */
+static prrte_hash_table_t *node_lookup = NULL;
+static int node_lookup_nodes = -1;
+
 /* IOF controls */
 bool prrte_tag_output = false;
 bool prrte_timestamp_output = false;
@@ -467,6 +471,91 @@ prrte_node_rank_t prrte_get_proc_node_rank(prrte_process_name_t *proc)
     return proct->node_rank;
 }
 
+static void node_lookup_add(char *name, int idx)
+{
+    void *ptr;
+
+    /* the pool is walked in index order, so keep the first node
+     * that claims a name - this matches what a linear search
+     * of the pool would find */
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(node_lookup, name, strlen(name), &ptr)) {
+        return;
+    }
+    /* store the pool index plus one so that index 0 is not a NULL value */
+    prrte_hash_table_set_value_ptr(node_lookup, name, strlen(name), (void*)(intptr_t)(idx + 1));
+}
+
+static void node_lookup_rebuild(void)
+{
+    prrte_node_t *node;
+    char *alias, **aliases;
+    int i, m;
+
+    if (NULL == node_lookup) {
+        node_lookup = PRRTE_NEW(prrte_hash_table_t);
+        prrte_hash_table_init(node_lookup, prrte_node_pool->size);
+    } else {
+        prrte_hash_table_remove_all(node_lookup);
+    }
+
+    for (i=0; i < prrte_node_pool->size; i++) {
+        if (NULL == (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
+            continue;
+        }
+        if (NULL == node->name) {
+            continue;
+        }
+        node_lookup_add(node->name, i);
+        if (prrte_get_attribute(&node->attributes, PRRTE_NODE_ALIAS, (void**)&alias, PRRTE_STRING)) {
+            aliases = prrte_argv_split(alias, ',');
+            free(alias);
+            for (m=0; NULL != aliases && NULL != aliases[m]; m++) {
+                node_lookup_add(aliases[m], i);
+            }
+            prrte_argv_free(aliases);
+        }
+    }
+    node_lookup_nodes = prrte_node_pool->size - prrte_node_pool->number_free;
+}
+
+prrte_node_t* prrte_node_lookup(char *name)
+{
+    prrte_node_t *node;
+    void *ptr;
+
+    if (NULL == prrte_node_pool || NULL == name) {
+        return NULL;
+    }
+    /* nodes are only ever added to the pool, so a change in the
+     * number of entries tells us the table is out of date */
+    if (NULL == node_lookup ||
+        node_lookup_nodes != (prrte_node_pool->size - prrte_node_pool->number_free)) {
+        node_lookup_rebuild();
+    }
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_ptr(node_lookup, name, strlen(name), &ptr)) {
+        return NULL;
+    }
+    node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, (int)((intptr_t)ptr - 1));
+    if (NULL == node) {
+        /* the slot was emptied behind our back - start over */
+        node_lookup_rebuild();
+        if (PRRTE_SUCCESS != prrte_hash_table_get_value_ptr(node_lookup, name, strlen(name), &ptr)) {
+            return NULL;
+        }
+        node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, (int)((intptr_t)ptr - 1));
+    }
+    return node;
+}
+
+void prrte_node_lookup_invalidate(void)
+{
+    if (NULL != node_lookup) {
+        PRRTE_RELEASE(node_lookup);
+        node_lookup = NULL;
+    }
+    node_lookup_nodes = -1;
+}
+
 bool prrte_node_match(prrte_node_t *n1, char *name)
 {
     char **n2names = NULL;
@@ -496,29 +585,23 @@ bool prrte_node_match(prrte_node_t *n1, char *name)
     }
 
     /* "name" itself might be an alias, so find the node object for this name */
-    for (i=0; i < prrte_node_pool->size; i++) {
-        if (NULL == (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
-            continue;
-        }
-        if (prrte_get_attribute(&nptr->attributes, PRRTE_NODE_ALIAS, (void**)&n2alias, PRRTE_STRING)) {
-            n2names = prrte_argv_split(n2alias, ',');
-            free(n2alias);
-        }
-        if (NULL == n2names) {
-            continue;
+    if (NULL == (nptr = prrte_node_lookup(name)) || nptr == n1) {
+        if (NULL != n1names) {
+            prrte_argv_free(n1names);
         }
-        /* no choice but an exhaustive search - fortunately, these lists are short! */
-        for (m=0; NULL != n2names[m]; m++) {
-            if (0 == strcmp(name, n2names[m])) {
-                /* this is the node! */
-                goto complete;
-            }
+        return false;
+    }
+    if (prrte_get_attribute(&nptr->attributes, PRRTE_NODE_ALIAS, (void**)&n2alias, PRRTE_STRING)) {
+        n2names = prrte_argv_split(n2alias, ',');
+        free(n2alias);
+    }
+    if (NULL == n2names) {
+        if (NULL != n1names) {
+            prrte_argv_free(n1names);
         }
-        prrte_argv_free(n2names);
+        return false;
     }
-    return false;
 
-  complete:
     /* only get here is we found the node for "name" */
     if (NULL == n1names) {
         for (m=0; NULL != n2names[m]; m++) {
@@ -66,6 +66,7 @@ PRRTE_EXPORT extern FILE *prrte_xml_fp;   /* instantiated in src/runtime/prrte_g
 PRRTE_EXPORT extern bool prrte_help_want_aggregate;  /* instantiated in src/util/show_help.c */
 PRRTE_EXPORT extern char *prrte_job_ident;  /* instantiated in src/runtime/prrte_globals.c */
 PRRTE_EXPORT extern bool prrte_create_session_dirs;  /* instantiated in src/runtime/prrte_init.c */
+PRRTE_EXPORT extern int prrte_session_dir_cleanup_threads;  /* instantiated in src/runtime/prrte_init.c */
 PRRTE_EXPORT extern bool prrte_execute_quiet;  /* instantiated in src/runtime/prrte_globals.c */
 PRRTE_EXPORT extern bool prrte_report_silent_errors;  /* instantiated in src/runtime/prrte_globals.c */
 PRRTE_EXPORT extern prrte_event_base_t *prrte_event_base;  /* instantiated in src/runtime/prrte_init.c */
@@ -435,6 +436,14 @@ PRRTE_EXPORT prrte_node_rank_t prrte_get_proc_node_rank(prrte_process_name_t *pr
 /* check to see if two nodes match */
 PRRTE_EXPORT bool prrte_node_match(prrte_node_t *n1, char *name);
 
+/* find the node in the node pool with the given name or alias, using
+ * a hashed index that is rebuilt whenever the pool changes */
+PRRTE_EXPORT prrte_node_t* prrte_node_lookup(char *name);
+
+/* discard the node lookup index - must be called whenever the name
+ * or aliases of a node already in the pool are changed */
+PRRTE_EXPORT void prrte_node_lookup_invalidate(void);
+
 /* global variables used by RTE - instanced in prrte_globals.c */
 PRRTE_EXPORT extern bool prrte_debug_daemons_flag;
 PRRTE_EXPORT extern bool prrte_debug_daemons_file_flag;
@@ -89,6 +89,7 @@ bool prrte_debug_flag = false;
 int prrte_debug_verbosity = -1;
 char *prrte_prohibited_session_dirs = NULL;
 bool prrte_create_session_dirs = true;
+int prrte_session_dir_cleanup_threads = 1;
 prrte_event_base_t *prrte_event_base = {0};
 bool prrte_event_base_active = true;
 bool prrte_proc_is_bound = false;
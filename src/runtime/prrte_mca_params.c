@@ -376,6 +376,13 @@ int prrte_register_params(void)
                                   PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prrte_create_session_dirs);
 
+    prrte_session_dir_cleanup_threads = 1;
+    (void) prrte_mca_base_var_register ("prrte", "prrte", NULL, "session_dir_cleanup_threads",
+                                  "Number of threads used to remove the per-job and per-proc session directories during cleanup (default=1)",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_session_dir_cleanup_threads);
+
     prrte_execute_quiet = false;
     (void) prrte_mca_base_var_register ("prrte", "prrte", NULL, "execute_quiet",
                                   "Do not output error and help messages",
@@ -1467,6 +1467,14 @@ int prun(int argc, char *argv[])
     }
     /* push our stdin to the apps */
     PMIX_LOAD_PROCID(&pname, nspace, 0);  // forward stdin to rank=0
+    if (NULL != (pval = prrte_cmd_line_get_param(prrte_cmd_line, "stdin", 0, 0))) {
+        if (0 == strcmp(pval->data.string, "all")) {
+            /* the DVM sends a single copy down the daemon tree */
+            pname.rank = PMIX_RANK_WILDCARD;
+        } else if (0 != strcmp(pval->data.string, "none")) {
+            pname.rank = strtoul(pval->data.string, NULL, 10);
+        }
+    }
     PMIX_INFO_CREATE(iptr, 1);
     PMIX_INFO_LOAD(&iptr[0], PMIX_IOF_PUSH_STDIN, NULL, PMIX_BOOL);
     PRRTE_PMIX_CONSTRUCT_LOCK(&lock);
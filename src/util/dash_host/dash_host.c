@@ -29,6 +29,7 @@
 #include "constants.h"
 #include "types.h"
 
+#include "src/class/prrte_hash_table.h"
 #include "src/util/show_help.h"
 #include "src/util/argv.h"
 #include "src/util/if.h"
@@ -462,6 +463,8 @@ int prrte_util_filter_dash_host_nodes(prrte_list_t *nodes,
     bool want_all_empty=false;
     char *cptr;
     size_t lst, lmn;
+    prrte_hash_table_t *names = NULL;
+    void *ptr;
 
     /* if the incoming node list is empty, then there
      * is nothing to filter!
@@ -524,7 +527,10 @@ int prrte_util_filter_dash_host_nodes(prrte_list_t *nodes,
                         }
                     }
                     if (remove) {
-                        /* remove item from list */
+                        /* remove item from list and the name index */
+                        if (NULL != names) {
+                            prrte_hash_table_remove_value_ptr(names, node->name, strlen(node->name));
+                        }
                         prrte_list_remove_item(nodes, item);
                         /* xfer to keep list */
                         prrte_list_append(&keep, item);
@@ -547,6 +553,38 @@ int prrte_util_filter_dash_host_nodes(prrte_list_t *nodes,
              * alias, so we only have to do a strcmp here. */
             cptr = NULL;
             lmn = strtoul(mapped_nodes[i], &cptr, 10);
+            if (!prrte_managed_allocation ||
+                (NULL != cptr && 0 < strlen(cptr))) {
+                /* a plain name match - index the incoming nodes by
+                 * name the first time we need it so that each entry
+                 * is a hash lookup instead of a walk of the list */
+                if (NULL == names) {
+                    names = PRRTE_NEW(prrte_hash_table_t);
+                    prrte_hash_table_init(names, prrte_list_get_size(nodes));
+                    PRRTE_LIST_FOREACH(node, nodes, prrte_node_t) {
+                        /* the first node on the list with a given name wins */
+                        if (PRRTE_SUCCESS != prrte_hash_table_get_value_ptr(names, node->name,
+                                                                            strlen(node->name), &ptr)) {
+                            prrte_hash_table_set_value_ptr(names, node->name, strlen(node->name), node);
+                        }
+                    }
+                }
+                if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(names, mapped_nodes[i],
+                                                                   strlen(mapped_nodes[i]), &ptr)) {
+                    node = (prrte_node_t*)ptr;
+                    if (remove) {
+                        /* remove item from list and the name index */
+                        prrte_hash_table_remove_value_ptr(names, node->name, strlen(node->name));
+                        prrte_list_remove_item(nodes, &node->super);
+                        /* xfer to keep list */
+                        prrte_list_append(&keep, &node->super);
+                    } else {
+                        /* mark the node as found */
+                        PRRTE_FLAG_SET(node, PRRTE_NODE_FLAG_MAPPED);
+                    }
+                }
+                goto nextentry;
+            }
             item = prrte_list_get_first(nodes);
             while (item != prrte_list_get_end(nodes)) {
                 next = prrte_list_get_next(item);  /* save this position */
@@ -575,7 +613,10 @@ int prrte_util_filter_dash_host_nodes(prrte_list_t *nodes,
                 }
                 if (0 == test) {
                     if (remove) {
-                        /* remove item from list */
+                        /* remove item from list and the name index */
+                        if (NULL != names) {
+                            prrte_hash_table_remove_value_ptr(names, node->name, strlen(node->name));
+                        }
                         prrte_list_remove_item(nodes, item);
                         /* xfer to keep list */
                         prrte_list_append(&keep, item);
@@ -588,6 +629,7 @@ int prrte_util_filter_dash_host_nodes(prrte_list_t *nodes,
                 item = next;
             }
         }
+      nextentry:
         /* done with the mapped entry */
         free(mapped_nodes[i]);
         mapped_nodes[i] = NULL;
@@ -640,6 +682,9 @@ cleanup:
     if (NULL != mapped_nodes) {
         free(mapped_nodes);
     }
+    if (NULL != names) {
+        PRRTE_RELEASE(names);
+    }
 
     return rc;
 }
@@ -442,6 +442,9 @@ int prrte_util_decode_nidmap(prrte_buffer_t *buf)
         prrte_process_info.max_procs = prrte_process_info.num_procs;
     }
 
+    /* the node pool was rebuilt */
+    prrte_node_lookup_invalidate();
+
   cleanup:
     if (NULL != vp8) {
         free(vp8);
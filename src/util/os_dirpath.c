@@ -37,12 +37,16 @@
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
 #endif  /* HAVE_DIRENT_H */
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif  /* HAVE_FCNTL_H */
 
 #include "src/util/output.h"
 #include "src/util/os_dirpath.h"
 #include "src/util/show_help.h"
 #include "src/util/argv.h"
 #include "src/util/os_path.h"
+#include "src/threads/threads.h"
 #include "constants.h"
 
 static const char path_sep[] = PRRTE_PATH_SEP;
@@ -137,40 +141,149 @@ int prrte_os_dirpath_create(const char *path, const mode_t mode)
     return PRRTE_SUCCESS;
 }
 
-/**
- * This function attempts to remove a directory along with all the
- * files in it.  If the recursive variable is non-zero, then it will
- * try to recursively remove all directories.  If provided, the
- * callback function is executed prior to the directory or file being
- * removed.  If the callback returns non-zero, then no removal is
- * done.
- */
-int prrte_os_dirpath_destroy(const char *path,
-                            bool recursive,
-                            prrte_os_dirpath_destroy_callback_fn_t cbfunc)
+int prrte_os_dirpath_create_batch(const char *parent, char **names, const mode_t mode)
 {
-    int rc, exit_status = PRRTE_SUCCESS;
-    bool is_dir = false;
-    DIR *dp;
-    struct dirent *ep;
-    char *filenm;
     struct stat buf;
+    int i, dfd, ret;
 
-    if (NULL == path) {  /* protect against error */
+    if (NULL == parent) { /* protect ourselves from errors */
+        return(PRRTE_ERR_BAD_PARAM);
+    }
+
+    /* make sure the parent exists */
+    if (PRRTE_SUCCESS != (ret = prrte_os_dirpath_create(parent, mode))) {
+        return ret;
+    }
+    if (NULL == names) {
+        return PRRTE_SUCCESS;
+    }
+
+    /* create everything relative to the parent so we don't
+     * have to resolve the full path for each entry */
+    dfd = open(parent, O_RDONLY | O_DIRECTORY);
+    if (0 > dfd) {
+        prrte_show_help("help-prrte-util.txt", "mkdir-failed", true,
+                        parent, strerror(errno));
         return PRRTE_ERROR;
     }
 
-    /*
-     * Make sure we have access to the the base directory
-     */
-    if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_access(path, 0))) {
-        exit_status = rc;
-        goto cleanup;
+    for (i=0; NULL != names[i]; i++) {
+        if (0 == mkdirat(dfd, names[i], mode)) {
+            continue;
+        }
+        ret = errno;
+        if (EEXIST != ret || 0 != fstatat(dfd, names[i], &buf, 0)) {
+            prrte_show_help("help-prrte-util.txt", "mkdir-failed", true,
+                            names[i], strerror(ret));
+            close(dfd);
+            return PRRTE_ERROR;
+        }
+        /* already exists - check the mode as dirpath_create would */
+        if (mode != (mode & buf.st_mode) &&
+            0 != fchmodat(dfd, names[i], (buf.st_mode | mode), 0)) {
+            prrte_show_help("help-prrte-util.txt", "dir-mode", true,
+                            names[i], mode, strerror(errno));
+            close(dfd);
+            return(PRRTE_ERR_PERM); /* can't set correct mode */
+        }
     }
 
-    /* Open up the directory */
-    dp = opendir(path);
+    close(dfd);
+    return PRRTE_SUCCESS;
+}
+
+/* shared state for the threads removing the top-level
+ * subdirectories of a tree in parallel */
+typedef struct {
+    prrte_mutex_t lock;
+    int dfd;
+    const char *path;
+    char **dirs;
+    int next;
+    bool recursive;
+    prrte_os_dirpath_destroy_callback_fn_t cbfunc;
+    int rc;
+} destroy_work_t;
+
+static int destroy_dir(int dfd, const char *path, bool recursive,
+                       prrte_os_dirpath_destroy_callback_fn_t cbfunc,
+                       int nthreads);
+
+/* remove the subdirectory "name" of the directory open on dfd */
+static int destroy_subdir(int dfd, const char *path, const char *name,
+                          bool recursive,
+                          prrte_os_dirpath_destroy_callback_fn_t cbfunc)
+{
+    int fd, rc;
+    char *filenm;
+
+    fd = openat(dfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+    if (0 > fd) {
+        /* may have been removed by another process on the node */
+        return (ENOENT == errno) ? PRRTE_SUCCESS : PRRTE_ERROR;
+    }
+    filenm = prrte_os_path(false, path, name, NULL);
+    rc = destroy_dir(fd, filenm, recursive, cbfunc, 1);
+    free(filenm);
+    /* if the directory is now empty, then remove it */
+    (void)unlinkat(dfd, name, AT_REMOVEDIR);
+    return rc;
+}
+
+static void drain_work(destroy_work_t *work)
+{
+    char *name;
+    int rc;
+
+    while (1) {
+        prrte_mutex_lock(&work->lock);
+        name = work->dirs[work->next];
+        if (NULL != name) {
+            ++work->next;
+        }
+        prrte_mutex_unlock(&work->lock);
+        if (NULL == name) {
+            break;
+        }
+        rc = destroy_subdir(work->dfd, work->path, name,
+                            work->recursive, work->cbfunc);
+        if (PRRTE_SUCCESS != rc) {
+            prrte_mutex_lock(&work->lock);
+            work->rc = rc;
+            prrte_mutex_unlock(&work->lock);
+        }
+    }
+}
+
+static void* destroy_worker(prrte_object_t *obj)
+{
+    prrte_thread_t *t = (prrte_thread_t*)obj;
+
+    drain_work((destroy_work_t*)t->t_arg);
+    return NULL;
+}
+
+/* remove the contents of the directory open on dfd, using the
+ * *at functions so the entries are resolved relative to it. The
+ * path is only needed for the callback. If nthreads > 1, the
+ * subdirectories are removed by that many threads once all the
+ * plain files have been unlinked. The fd is closed on return */
+static int destroy_dir(int dfd, const char *path, bool recursive,
+                       prrte_os_dirpath_destroy_callback_fn_t cbfunc,
+                       int nthreads)
+{
+    int i, n, rc, exit_status = PRRTE_SUCCESS;
+    bool is_dir;
+    DIR *dp;
+    struct dirent *ep;
+    struct stat buf;
+    char **dirs = NULL;
+    destroy_work_t work;
+    prrte_thread_t *threads;
+
+    dp = fdopendir(dfd);
     if (NULL == dp) {
+        close(dfd);
         return PRRTE_ERROR;
     }
 
@@ -183,28 +296,17 @@ int prrte_os_dirpath_destroy(const char *path,
             continue;
         }
 
-        /* Check to see if it is a directory */
-        is_dir = false;
-
-        /* Create a pathname.  This is not always needed, but it makes
-         * for cleaner code just to create it here.  Note that we are
-         * allocating memory here, so we need to free it later on.
-         */
-        filenm = prrte_os_path(false, path, ep->d_name, NULL);
-
-        rc = stat(filenm, &buf);
-        if (0 > rc) {
-            /* Handle a race condition. filenm might have been deleted by an
+        /* Check to see if it is a directory - we do not
+         * follow symlinks out of the tree */
+        if (0 > fstatat(dfd, ep->d_name, &buf, AT_SYMLINK_NOFOLLOW)) {
+            /* Handle a race condition. The entry might have been deleted by an
              * other process running on the same node. That typically occurs
              * when one task is removing the job_session_dir and an other task
              * is still removing its proc_session_dir.
              */
-            free(filenm);
             continue;
         }
-        if (S_ISDIR(buf.st_mode)) {
-            is_dir = true;
-        }
+        is_dir = S_ISDIR(buf.st_mode);
 
         /*
          * If not recursively decending, then if we find a directory then fail
@@ -215,7 +317,6 @@ int prrte_os_dirpath_destroy(const char *path,
              * but continue removing files
              */
             exit_status = PRRTE_ERROR;
-            free(filenm);
             continue;
         }
 
@@ -226,30 +327,112 @@ int prrte_os_dirpath_destroy(const char *path,
              * continue with the rest of the entries
              */
             if (!(cbfunc(path, ep->d_name))) {
-                free(filenm);
                 continue;
             }
         }
-        /* Directories are recursively destroyed */
-        if (is_dir) {
-            rc = prrte_os_dirpath_destroy(filenm, recursive, cbfunc);
-            free(filenm);
+
+        if (!is_dir) {
+            /* Files are removed right here */
+            if (0 != unlinkat(dfd, ep->d_name, 0)) {
+                exit_status = PRRTE_ERROR;
+            }
+        } else if (1 < nthreads) {
+            /* save it for the threads */
+            prrte_argv_append_nosize(&dirs, ep->d_name);
+        } else {
+            /* Directories are recursively destroyed */
+            rc = destroy_subdir(dfd, path, ep->d_name, recursive, cbfunc);
             if (PRRTE_SUCCESS != rc) {
                 exit_status = rc;
-                closedir(dp);
-                goto cleanup;
+                break;
             }
-        } else {
-            /* Files are removed right here */
-            if (0 != (rc = unlink(filenm))) {
-                exit_status = PRRTE_ERROR;
+        }
+    }
+
+    if (NULL != dirs) {
+        n = prrte_argv_count(dirs);
+        if (n < nthreads) {
+            nthreads = n;
+        }
+        PRRTE_CONSTRUCT(&work.lock, prrte_mutex_t);
+        work.dfd = dfd;
+        work.path = path;
+        work.dirs = dirs;
+        work.next = 0;
+        work.recursive = recursive;
+        work.cbfunc = cbfunc;
+        work.rc = PRRTE_SUCCESS;
+        threads = (prrte_thread_t*)malloc(nthreads * sizeof(prrte_thread_t));
+        for (i=0, n=0; NULL != threads && i < nthreads; i++) {
+            PRRTE_CONSTRUCT(&threads[i], prrte_thread_t);
+            threads[i].t_run = destroy_worker;
+            threads[i].t_arg = &work;
+            if (PRRTE_SUCCESS != prrte_thread_start(&threads[i])) {
+                PRRTE_DESTRUCT(&threads[i]);
+                break;
             }
-            free(filenm);
+            ++n;
+        }
+        /* whatever the threads don't get to, we do */
+        drain_work(&work);
+        for (i=0; i < n; i++) {
+            prrte_thread_join(&threads[i], NULL);
+            PRRTE_DESTRUCT(&threads[i]);
+        }
+        if (NULL != threads) {
+            free(threads);
         }
+        if (PRRTE_SUCCESS != work.rc) {
+            exit_status = work.rc;
+        }
+        PRRTE_DESTRUCT(&work.lock);
+        prrte_argv_free(dirs);
     }
 
     /* Done with this directory */
     closedir(dp);
+    return exit_status;
+}
+
+/**
+ * This function attempts to remove a directory along with all the
+ * files in it.  If the recursive variable is non-zero, then it will
+ * try to recursively remove all directories.  If provided, the
+ * callback function is executed prior to the directory or file being
+ * removed.  If the callback returns non-zero, then no removal is
+ * done.
+ */
+int prrte_os_dirpath_destroy(const char *path,
+                            bool recursive,
+                            prrte_os_dirpath_destroy_callback_fn_t cbfunc)
+{
+    return prrte_os_dirpath_destroy_parallel(path, recursive, cbfunc, 1);
+}
+
+int prrte_os_dirpath_destroy_parallel(const char *path,
+                                     bool recursive,
+                                     prrte_os_dirpath_destroy_callback_fn_t cbfunc,
+                                     int nthreads)
+{
+    int rc, dfd;
+
+    if (NULL == path) {  /* protect against error */
+        return PRRTE_ERROR;
+    }
+
+    /*
+     * Make sure we have access to the the base directory
+     */
+    if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_access(path, 0))) {
+        goto cleanup;
+    }
+
+    /* Open up the directory */
+    dfd = open(path, O_RDONLY | O_DIRECTORY);
+    if (0 > dfd) {
+        return PRRTE_ERROR;
+    }
+    rc = destroy_dir(dfd, path, recursive, cbfunc, nthreads);
 
  cleanup:
 
@@ -260,7 +443,7 @@ int prrte_os_dirpath_destroy(const char *path,
         rmdir(path);
     }
 
-    return exit_status;
+    return rc;
 }
 
 bool prrte_os_dirpath_is_empty(const char *path ) {
@@ -60,6 +60,24 @@ BEGIN_C_DECLS
 
 PRRTE_EXPORT int prrte_os_dirpath_create(const char *path, const mode_t mode);
 
+/**
+ * Create a set of directories under a common parent
+ *
+ * The parent is created as by prrte_os_dirpath_create(), and each
+ * entry is then created relative to it - this is much cheaper than
+ * creating each full path when there are many siblings
+ *
+ * @param parent A pointer to a string that contains the parent path name.
+ * @param names A NULL-terminated argv of names to create under the parent.
+ * @param mode A mode_t bit mask that specifies the access permissions for the
+ * directories being constructed.
+ * @retval PRRTE_SUCCESS If all directories have been successfully created with
+ * the specified access permissions.
+ * @retval PRRTE_ERROR If any of the directories could not be created.
+ */
+PRRTE_EXPORT int prrte_os_dirpath_create_batch(const char *parent, char **names,
+                                               const mode_t mode);
+
 /**
  * Check to see if a directory is empty
  *
@@ -114,6 +132,21 @@ PRRTE_EXPORT int prrte_os_dirpath_destroy(const char *path,
                                           bool recursive,
                                           prrte_os_dirpath_destroy_callback_fn_t cbfunc);
 
+/**
+ * Destroy a directory, removing its top-level subdirectories in parallel
+ *
+ * Behaves as prrte_os_dirpath_destroy(), except that the subdirectories
+ * found directly under the path are divided among up to nthreads threads.
+ * The callback must be safe to call from multiple threads.
+ *
+ * @param nthreads Max number of threads to use - a value <= 1 removes
+ *                 the tree serially.
+ */
+PRRTE_EXPORT int prrte_os_dirpath_destroy_parallel(const char *path,
+                                                   bool recursive,
+                                                   prrte_os_dirpath_destroy_callback_fn_t cbfunc,
+                                                   int nthreads);
+
 END_C_DECLS
 
 #endif
@@ -377,8 +377,9 @@ prrte_session_dir_cleanup(prrte_jobid_t jobid)
     /* recursively blow the whole session away for our job family,
      * saving only output files
      */
-    prrte_os_dirpath_destroy(prrte_process_info.jobfam_session_dir,
-                            true, prrte_dir_check_file);
+    prrte_os_dirpath_destroy_parallel(prrte_process_info.jobfam_session_dir,
+                                     true, prrte_dir_check_file,
+                                     prrte_session_dir_cleanup_threads);
 
     if (prrte_os_dirpath_is_empty(prrte_process_info.jobfam_session_dir)) {
         if (prrte_debug_flag) {
@@ -572,7 +573,7 @@ prrte_dir_check_file(const char *root, const char *path)
      *  - non-zero files starting with "output-"
      */
     if (0 == strncmp(path, "output-", strlen("output-"))) {
-        fullpath = prrte_os_path(false, &fullpath, root, path, NULL);
+        fullpath = prrte_os_path(false, root, path, NULL);
         stat(fullpath, &st);
         free(fullpath);
         if (0 == st.st_size) {